@@ -0,0 +1,62 @@
+#ifndef ASYNC_GWO_HPP
+#define ASYNC_GWO_HPP
+
+#include <vector>
+#include <functional>
+#include <cstddef>
+#include <cstdint>
+
+#include "GWO.hpp"
+
+/**
+ * @brief Asynchronous, steady-state Grey Wolf Optimizer for expensive objectives.
+ *
+ * The generational optimizer evaluates the whole pack and then waits for the slowest
+ * evaluation before it selects the leaders and moves the wolves. When evaluation
+ * times vary a lot between points, most threads sit idle at that barrier. This
+ * version has no generations:
+ * - every wolf's position is evaluated as a job on a `TaskScheduler`, and finished
+ *   evaluations are posted to a completion queue;
+ * - the calling thread takes completions one at a time, updates alpha, beta and delta
+ *   with the result, moves that wolf towards the current leaders and dispatches its
+ *   new position at once, so a worker never waits for the rest of the pack.
+ *
+ * Alpha, beta and delta are the three fittest wolves, each taken at the last point
+ * at which it was evaluated, so they change as soon as a wolf improves. `a` follows
+ * `compute_a(max_evaluations, dispatched)`, so it decreases over the budget instead of
+ * over iterations. At most one evaluation per wolf is in flight, so `population`
+ * should be at least the number of threads to keep every worker busy.
+ *
+ * Since the order of completions depends on timing, runs are not reproducible with
+ * more than one thread, even with a fixed seed.
+ *
+ * @param function The objective. It is called from the worker threads and must be thread-safe.
+ * @param lowerbound The lower bound of each dimension of the search space.
+ * @param upperbound The upper bound of each dimension of the search space.
+ * @param population The number of wolves in the pack; at least 3.
+ * @param max_evaluations The evaluation budget, including the initial evaluation of every wolf.
+ * @param seed The seed of the per-wolf random streams.
+ * @param threads The number of worker threads; 0 uses one per hardware thread.
+ * @param compute_a The schedule of `a`, called as `compute_a(max_evaluations, evaluations_dispatched)`.
+ * @param stats If not null, receives the number of evaluations, the number of whole passes
+ *              over the pack they amount to (`iterations`, `evaluations / population`), the
+ *              wall time of the run (`evaluation_seconds`), the worker time spent idle
+ *              (`evaluation_wait_seconds`) and the time the calling thread spent updating
+ *              wolves (`update_seconds`).
+ *
+ * @return The best position found and its fitness.
+ *
+ * @throws std::invalid_argument if `population` is below 3 or the bounds differ in size.
+ * @throws Rethrows the first exception thrown by `function`, once the evaluations
+ *         already in flight have finished.
+ */
+std::pair<std::vector<double>, double> GreyWolfOptimizerAsync(
+    const std::function<double(const std::vector<double>&)>& function,
+    const std::vector<double>& lowerbound,
+    const std::vector<double>& upperbound,
+    int population, int max_evaluations, std::uint64_t seed,
+    std::size_t threads = 0,
+    const std::function<double(int, int)>& compute_a = compute_a,
+    GwoStats* stats = nullptr);
+
+#endif // ASYNC_GWO_HPP
@@ -0,0 +1,51 @@
+#ifndef BATCH_OBJECTIVE_HPP
+#define BATCH_OBJECTIVE_HPP
+
+#include <cstddef>
+#include <vector>
+#include <functional>
+
+#include "Span.hpp"
+
+/**
+ * @brief Read-only, row-major view of the positions of a whole pack.
+ *
+ * Wolf `i` occupies `dimension` contiguous values starting at `data + i * stride`;
+ * rows are 64-byte aligned and `stride >= dimension` (the padding is zero).
+ */
+template <typename Scalar>
+struct BasicPopulationView {
+    const Scalar* data;
+    std::size_t population;
+    std::size_t dimension;
+    std::size_t stride;
+
+    Span<const Scalar> row(std::size_t wolf) const {
+        return Span<const Scalar>(data + wolf * stride, dimension);
+    }
+};
+
+/// View of a double-precision pack, the one batch objectives receive.
+using PopulationView = BasicPopulationView<double>;
+
+/// View of a single-precision pack, received by batch objectives of `FloatGwoWorkspace` runs.
+using FloatPopulationView = BasicPopulationView<float>;
+
+/**
+ * @brief Objective that evaluates a whole population in a single call.
+ *
+ * It receives every position at once and must write the fitness of wolf `i` to
+ * `fitness[i]`, which lets it vectorize across wolves, reuse work between them and
+ * manage its own parallelism. It is called from a single thread.
+ */
+using BatchObjective = std::function<void(const PopulationView& positions, Span<double> fitness)>;
+
+/**
+ * @brief Adapts a per-point objective (such as those in functions.hpp) to the batch interface.
+ *
+ * The returned objective evaluates the rows in parallel with OpenMP, copying each
+ * one into a per-thread scratch vector, so `function` must be thread-safe.
+ */
+BatchObjective make_batch_objective(std::function<double(const std::vector<double>&)> function);
+
+#endif // BATCH_OBJECTIVE_HPP
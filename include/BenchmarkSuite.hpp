@@ -0,0 +1,32 @@
+#ifndef BENCHMARK_SUITE_HPP
+#define BENCHMARK_SUITE_HPP
+
+#include <vector>
+#include <functional>
+#include <string>
+
+/**
+ * @brief A benchmark function together with its search domain.
+ */
+struct BenchmarkFunction {
+    std::function<double(const std::vector<double>&)> func;
+    std::vector<double> lower_bound;
+    std::vector<double> upper_bound;
+    std::string name;
+};
+
+/**
+ * @brief The standard set of 18 benchmark functions, shared by the `Testing` driver and the benchmarks.
+ *
+ * @param dimensions The dimension used for the functions defined for any number of variables;
+ *                   the others keep their fixed dimension (2 or 4).
+ */
+std::vector<BenchmarkFunction> make_benchmark_functions(int dimensions);
+
+/**
+ * @brief The same functions, in the same order and with the same parameters and domains,
+ *        evaluated by the plain implementations of ReferenceFunctions.hpp.
+ */
+std::vector<BenchmarkFunction> make_reference_functions(int dimensions);
+
+#endif // BENCHMARK_SUITE_HPP
@@ -0,0 +1,124 @@
+#ifndef CHECKPOINT_HPP
+#define CHECKPOINT_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief The state of a run of `GreyWolfOptimizerT` between two iterations.
+ *
+ * Holds everything the next iterations depend on: the positions of the pack, the
+ * per-wolf random streams, the best solution so far, the evaluation and iteration
+ * counts and the state of the stagnation criterion. Resuming from it gives the same
+ * results as a run that was never interrupted.
+ */
+struct GwoCheckpoint {
+    std::uint64_t seed = 0;
+    std::uint64_t population = 0;
+    std::uint64_t dimension = 0;
+    std::uint64_t iter = 0;                 ///< The iteration count of the run.
+    std::uint64_t next_iteration = 0;       ///< The iteration to resume at.
+
+    long long evaluations = 0;
+    int iterations = 0;
+    double best_fitness = 0.0;
+    double stagnation_reference = 0.0;      ///< Best fitness at the last improvement.
+    bool stagnation_started = false;
+    int stagnant_iterations = 0;
+
+    std::vector<double> best_position;      ///< `dimension` values.
+    std::vector<double> positions;          ///< `population` rows of `dimension` values, unpadded.
+    std::vector<double> fitness;            ///< `population` values.
+    std::vector<std::uint64_t> rng_state;   ///< The state words of every wolf's stream, in order.
+};
+
+/**
+ * @brief Writes `state` to `path` in a versioned binary format.
+ *
+ * The data goes to a temporary file next to `path`, which is synced and then renamed
+ * over it, so `path` always holds either the previous or the new checkpoint, never a
+ * partial one.
+ *
+ * @throws std::runtime_error if the file cannot be written.
+ */
+void write_checkpoint(const std::string& path, const GwoCheckpoint& state);
+
+/**
+ * @brief Reads a checkpoint written by `write_checkpoint`.
+ *
+ * @return false, leaving `state` untouched, if `path` does not exist.
+ *
+ * @throws std::runtime_error if the file cannot be read, has another version or is corrupt.
+ */
+bool read_checkpoint(const std::string& path, GwoCheckpoint& state);
+
+/**
+ * @brief Periodic, asynchronous checkpointing of a run to one file.
+ *
+ * Passed to the optimizer, it resumes the run from `path` if the file exists and then
+ * saves the state every `interval` iterations. `save` only copies the state and returns;
+ * a background thread writes it. If a write is still running when the next snapshot
+ * arrives, the older pending snapshot is replaced, so a slow disk never stalls the
+ * iteration loop. The destructor writes the last pending snapshot before returning.
+ */
+class Checkpointer {
+public:
+    /**
+     * @param path The checkpoint file, read on resume and replaced by every write.
+     * @param interval The number of iterations between two snapshots; 0 only resumes.
+     */
+    Checkpointer(std::string path, int interval);
+    ~Checkpointer();
+
+    Checkpointer(const Checkpointer&) = delete;
+    Checkpointer& operator=(const Checkpointer&) = delete;
+
+    const std::string& path() const { return path_; }
+    int interval() const { return interval_; }
+
+    /// True if a snapshot is due once `completed_iterations` iterations have run.
+    bool due(int completed_iterations) const {
+        return interval_ > 0 && completed_iterations % interval_ == 0;
+    }
+
+    /// Reads the checkpoint file; false if there is none. See `read_checkpoint`.
+    bool load(GwoCheckpoint& state) const { return read_checkpoint(path_, state); }
+
+    /**
+     * @brief Queues a copy of `state` to be written in the background.
+     *
+     * @throws std::runtime_error if an earlier write failed.
+     */
+    void save(const GwoCheckpoint& state);
+
+    /**
+     * @brief Waits until every queued snapshot has been written.
+     *
+     * @throws std::runtime_error if a write failed.
+     */
+    void flush();
+
+private:
+    void run();
+
+    std::string path_;
+    int interval_;
+
+    std::mutex mutex_;
+    std::condition_variable changed_;
+    GwoCheckpoint pending_;   ///< The latest snapshot not yet picked up by the writer.
+    GwoCheckpoint writing_;   ///< The snapshot being written, owned by the writer.
+    bool has_pending_ = false;
+    bool busy_ = false;
+    bool stop_ = false;
+    std::exception_ptr error_;
+    std::thread writer_;
+};
+
+#endif // CHECKPOINT_HPP
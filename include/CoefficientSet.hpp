@@ -0,0 +1,107 @@
+#ifndef COEFFICIENT_SET_HPP
+#define COEFFICIENT_SET_HPP
+
+#include <cstddef>
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Centers and weights of a Shekel or Langermann type objective.
+ *
+ * The `size()` centers of dimension `dimension()` are stored transposed in one flat,
+ * 64-byte aligned buffer: coordinate `j` of every center is a contiguous row of
+ * `stride()` doubles (the count rounded up to a cache line), followed by one row
+ * holding the weights. Distances from a point to a run of consecutive centers are then
+ * a vector loop over that run for each coordinate. Padding centers are at the origin
+ * with a zero weight, so loops may run over whole rows.
+ *
+ * The buffer is immutable and reference counted, so copies of a set (and of the
+ * objectives and `std::function`s holding one) share it instead of duplicating it.
+ * It is either owned memory or a read-only mapping of a file written by `save`.
+ */
+class CoefficientSet {
+public:
+    /// Number of doubles per cache line; rows are padded to a multiple of this.
+    static constexpr std::size_t row_alignment = 64 / sizeof(double);
+
+    CoefficientSet() = default;
+
+    /**
+     * @brief Copies centers given as rows, and one weight per center.
+     *
+     * @throws std::invalid_argument if the rows have different sizes or `weights`
+     *         does not have one value per row.
+     */
+    CoefficientSet(const std::vector<std::vector<double>>& centers, const std::vector<double>& weights);
+
+    /**
+     * @brief Memory-maps a set written by `save`.
+     *
+     * The pages are loaded on first use and shared with the page cache, so sets larger
+     * than memory can be used and several processes reading the same file share it.
+     *
+     * @throws std::runtime_error if the file cannot be mapped or is not a valid set.
+     */
+    static CoefficientSet load(const std::string& path);
+
+    /**
+     * @brief Writes the set in the binary format read by `load`.
+     *
+     * @throws std::runtime_error if the file cannot be written.
+     */
+    void save(const std::string& path) const;
+
+    std::size_t size() const { return size_; }
+    std::size_t dimension() const { return dimension_; }
+    std::size_t stride() const { return stride_; }
+
+    /// Coordinate `j` of every center, `stride()` doubles starting on a cache line.
+    const double* coordinate(std::size_t j) const { return data_.get() + j * stride_; }
+
+    /// Weight of every center, `stride()` doubles starting on a cache line.
+    const double* weights() const { return data_.get() + dimension_ * stride_; }
+
+    /// True if the buffer is a mapping of a file rather than owned memory.
+    bool mapped() const { return mapped_; }
+
+    /**
+     * @brief Squared distances from `x` to centers `first .. first + count`.
+     *
+     * Walks the coordinates one at a time over the whole run, so for runs of a few
+     * hundred centers `out` stays in L1 while the coordinates stream through.
+     */
+    void squared_distances(const double* x, std::size_t first, std::size_t count, double* out) const {
+        if (dimension_ == 0) {
+            std::fill(out, out + count, 0.0);
+            return;
+        }
+        // The first coordinate initializes `out`, saving a pass over it
+        const double* column = coordinate(0) + first;
+        #pragma omp simd
+        for (std::size_t k = 0; k < count; ++k) {
+            double difference = x[0] - column[k];
+            out[k] = difference * difference;
+        }
+        for (std::size_t j = 1; j < dimension_; ++j) {
+            column = coordinate(j) + first;
+            const double xj = x[j];
+
+            #pragma omp simd
+            for (std::size_t k = 0; k < count; ++k) {
+                double difference = xj - column[k];
+                out[k] += difference * difference;
+            }
+        }
+    }
+
+private:
+    std::shared_ptr<const double> data_;
+    std::size_t size_ = 0;
+    std::size_t dimension_ = 0;
+    std::size_t stride_ = 0;
+    bool mapped_ = false;
+};
+
+#endif // COEFFICIENT_SET_HPP
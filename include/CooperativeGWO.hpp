@@ -0,0 +1,381 @@
+#ifndef COOPERATIVE_GWO_HPP
+#define COOPERATIVE_GWO_HPP
+
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <limits>
+#include <stdexcept>
+#include <cmath>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "GWOCore.hpp"
+#include "Pack.hpp"
+#include "Profiler.hpp"
+#include "Random.hpp"
+#include "Span.hpp"
+#include "StoppingCriteria.hpp"
+#include "UpdateKernel.hpp"
+
+/**
+ * @brief Reusable buffers for `GreyWolfOptimizerCooperative`.
+ *
+ * The sub-packs of all blocks share one pack, the sub-pack of block `k` taking rows
+ * `k * population` to `(k + 1) * population - 1`, so the positions of the whole run
+ * take `population x dimension` doubles. As for `GwoWorkspace`, buffers only grow.
+ */
+struct CooperativeGwoWorkspace {
+    Pack pack;                                 ///< Every sub-pack, each `block_size` wide.
+    Pack leaders;                              ///< Copies of the alpha, beta and delta wolves of a block.
+    std::vector<int> order;                    ///< Wolf indices of a sub-pack, partially sorted by fitness.
+    std::vector<VectorRng> streams;            ///< One random stream per row of `pack`, then one for the context.
+    std::vector<double> context;               ///< The best complete solution found so far.
+    std::vector<double> block_terms;           ///< Separable objectives: each block's share of the context's fitness.
+    std::vector<double> centroid;              ///< Mean position of a sub-pack, for the diversity criterion.
+    std::vector<std::vector<double>> scratch;  ///< Other objectives: per-thread copies of the context.
+
+    /// Sizes every buffer for a run and seeds the random streams.
+    void prepare(std::size_t population, std::size_t dimension, std::size_t block_size, std::uint64_t seed,
+                 bool separable) {
+        const std::size_t blocks = (dimension + block_size - 1) / block_size;
+        pack.resize(blocks * population, block_size);
+        leaders.resize(3, block_size);
+        order.resize(population);
+        make_streams(seed, blocks * population + 1, streams);
+        context.resize(dimension);
+        block_terms.resize(blocks);
+        centroid.resize(block_size);
+
+        std::size_t threads = 0;
+        if (!separable) {
+            threads = 1;
+#ifdef _OPENMP
+            threads = static_cast<std::size_t>(omp_get_max_threads());
+#endif
+        }
+        if (scratch.size() < threads) {
+            scratch.resize(threads);
+        }
+        if (threads > 0) {
+            // Every row, since the run copies the context into all of them
+            for (std::vector<double>& row : scratch) {
+                row.resize(dimension);
+            }
+        }
+    }
+};
+
+namespace gwo_detail {
+
+// Objectives whose value is the sum of the `partial` values of any split into blocks
+template <typename Objective, typename = void>
+constexpr bool is_separable_objective = false;
+
+template <typename Objective>
+constexpr bool is_separable_objective<Objective, std::void_t<decltype(std::declval<const Objective&>().partial(
+    std::declval<Span<const double>>(), std::size_t()))>> = true;
+
+// The diversity of `pack_diversity`, for the rows `first` to `first + population - 1` of
+// a pack, with the bounds of their block
+inline double rows_diversity(const Pack& pack, std::size_t first, std::size_t population, std::size_t dimension,
+                             const double* lower, const double* upper, std::vector<double>& centroid) {
+    if (population == 0 || dimension == 0) return 0.0;
+
+    std::fill(centroid.begin(), centroid.begin() + dimension, 0.0);
+    double* mean = centroid.data();
+    for (std::size_t w = first; w < first + population; ++w) {
+        const double* position = pack.position(w);
+        #pragma omp simd
+        for (std::size_t j = 0; j < dimension; ++j) {
+            mean[j] += position[j];
+        }
+    }
+    for (std::size_t j = 0; j < dimension; ++j) {
+        mean[j] /= population;
+    }
+
+    double diversity = 0.0;
+    for (std::size_t j = 0; j < dimension; ++j) {
+        double variance = 0.0;
+        for (std::size_t w = first; w < first + population; ++w) {
+            double deviation = pack.position(w)[j] - mean[j];
+            variance += deviation * deviation;
+        }
+        double width = upper[j] - lower[j];
+        diversity += width > 0.0 ? std::sqrt(variance / population) / width : 0.0;
+    }
+    return diversity / dimension;
+}
+
+} // namespace gwo_detail
+
+/**
+ * @brief Grey Wolf Optimizer by cooperative coevolution, for very high dimensions.
+ *
+ * The coordinates are split into blocks of `block_size` (the last one may be smaller),
+ * and each block has its own sub-pack of `population` wolves. A context vector holds
+ * the best complete solution; a wolf of block `k` is evaluated as the context with its
+ * block replaced by the wolf. Each cycle gives every block in turn `block_iterations`
+ * iterations of the usual update, and a wolf that improves on the context is copied
+ * into it. The first wolf of each sub-pack starts at the initial context.
+ *
+ * With a separable objective (one implementing `partial`, such as `DeJongObjective`,
+ * `AxisParallelHyperEllipsoidObjective`, `RastringObjective` or `SchwefelObjective`),
+ * the fitness of the context is kept as one term per block. A wolf of block `k` is
+ * ranked by `partial` of its own block alone, since the other terms do not change
+ * during the block's turn, so it costs time proportional to the block rather than to
+ * the dimension. Other objectives taking a `Span<const double>` are called on a
+ * per-thread copy of the context, which costs a full evaluation per wolf.
+ *
+ * Evaluations counted in `stats` are calls to the objective, on a block or on a whole
+ * vector; an iteration is one iteration of one sub-pack. The schedule runs once over
+ * the whole run, `cycles * block_iterations` iterations long. The stopping criteria are
+ * checked after every iteration, with the diversity of the sub-pack that just moved.
+ * Phase timings are only measured when `stats` is not null.
+ *
+ * @param workspace The buffers to run in; see `CooperativeGwoWorkspace`.
+ * @param objective The objective to minimize.
+ * @param lowerbound The lower bound of each dimension of the search space.
+ * @param upperbound The upper bound of each dimension of the search space.
+ * @param block_size The number of coordinates each sub-pack optimizes.
+ * @param population The number of wolves of each sub-pack, at least 3.
+ * @param cycles The number of passes over all blocks.
+ * @param block_iterations The iterations of each block per cycle.
+ * @param seed The seed of the random streams.
+ * @param schedule A callable `double(int iter, int current_iter)` giving the value of `a`.
+ * @param stats If not null, receives the evaluation and iteration counts, the phase
+ *              timings and the reason the run stopped.
+ * @param criteria Conditions that end the run early; see `StoppingCriteria`.
+ *
+ * @return A view of the context, valid until the workspace is reused, and its fitness.
+ *
+ * @throws std::invalid_argument if the population is below 3, the block size is 0 or
+ *         the bounds differ in size.
+ */
+template <typename Objective, typename Schedule = LinearSchedule>
+std::pair<Span<const double>, double> GreyWolfOptimizerCooperative(
+    CooperativeGwoWorkspace& workspace,
+    const Objective& objective,
+    const std::vector<double>& lowerbound,
+    const std::vector<double>& upperbound,
+    std::size_t block_size, int population, int cycles, int block_iterations, std::uint64_t seed,
+    const Schedule& schedule = Schedule(),
+    GwoStats* stats = nullptr,
+    const StoppingCriteria& criteria = StoppingCriteria())
+{
+    static_assert(std::is_invocable_r_v<double, const Objective&, Span<const double>>,
+                  "The objective must be callable with Span<const double>");
+
+    using namespace gwo_detail;
+    constexpr bool separable = is_separable_objective<Objective>;
+
+    if (population < 3) {
+        throw std::invalid_argument("The pack needs at least 3 wolves.");
+    }
+    if (block_size == 0) {
+        throw std::invalid_argument("The block size must be at least 1.");
+    }
+    if (lowerbound.size() != upperbound.size()) {
+        throw std::invalid_argument("The lower and upper bounds must have the same size.");
+    }
+
+    auto run_start = Clock::now();
+    GWO_PROFILE_PHASE(ProfilePhase::initialization);
+    const std::size_t dimension = lowerbound.size();
+    const std::size_t blocks = (dimension + block_size - 1) / block_size;
+    workspace.prepare(population, dimension, block_size, seed, separable);
+
+    Pack& pack = workspace.pack;
+    Pack& leaders = workspace.leaders;
+    std::vector<int>& order = workspace.order;
+    std::vector<VectorRng>& streams = workspace.streams;
+    std::vector<double>& context = workspace.context;
+    std::vector<double>& block_terms = workspace.block_terms;
+    const double* lower = lowerbound.data();
+    const double* upper = upperbound.data();
+
+    // A random context, then the sub-packs around it
+    streams[blocks * population].fill_uniform(context.data(), dimension);
+    for (std::size_t j = 0; j < dimension; ++j) {
+        context[j] = lower[j] + context[j] * (upper[j] - lower[j]);
+    }
+
+    #pragma omp parallel for schedule(static)
+    for (int row = 0; row < static_cast<int>(blocks) * population; ++row) {
+        const std::size_t offset = row / population * block_size;
+        const std::size_t width = std::min(block_size, dimension - offset);
+        double* position = pack.position(row);
+        if (row % population == 0) {
+            std::copy(context.begin() + offset, context.begin() + offset + width, position);
+        } else {
+            streams[row].fill_uniform(position, width);
+            for (std::size_t j = 0; j < width; ++j) {
+                position[j] = lower[offset + j] + position[j] * (upper[offset + j] - lower[offset + j]);
+            }
+        }
+    }
+
+    GwoStats local_stats;
+    double best_fitness;
+    if constexpr (separable) {
+        for (std::size_t k = 0; k < blocks; ++k) {
+            const std::size_t offset = k * block_size;
+            block_terms[k] = objective.partial(
+                Span<const double>(context.data() + offset, std::min(block_size, dimension - offset)), offset);
+        }
+        local_stats.evaluations += static_cast<long long>(blocks);
+        best_fitness = std::accumulate(block_terms.begin(), block_terms.end(), 0.0);
+    } else {
+        for (std::vector<double>& copy : workspace.scratch) {
+            std::copy(context.begin(), context.end(), copy.begin());
+        }
+        best_fitness = objective(Span<const double>(context));
+        local_stats.evaluations += 1;
+    }
+
+    StopMonitor monitor(criteria, run_start);
+    const bool timed = stats != nullptr;
+    const int total_iterations = cycles * block_iterations;
+    bool stopped = false;
+
+    for (int cycle = 0; cycle < cycles && !stopped; ++cycle) {
+        for (std::size_t k = 0; k < blocks && !stopped; ++k) {
+            const std::size_t offset = k * block_size;
+            const std::size_t width = std::min(block_size, dimension - offset);
+            const int first = static_cast<int>(k) * population;
+            // The other blocks do not change during this block's turn, so wolves of a separable
+            // objective are ranked on their block's term alone, against the context's term
+            const double rest = separable ? best_fitness - block_terms[k] : 0.0;
+            double incumbent = separable ? block_terms[k] : best_fitness;
+
+            for (int t = 0; t < block_iterations; ++t) {
+                if (monitor.budget_exhausted(local_stats, population)) {
+                    local_stats.stop_reason = StopReason::max_evaluations;
+                    stopped = true;
+                    break;
+                }
+
+                // Evaluate the sub-pack in the context
+                GWO_PROFILE_PHASE(ProfilePhase::evaluation);
+                Clock::time_point evaluation_start;
+                if (timed) evaluation_start = Clock::now();
+                BestIndex iteration_best;
+
+                #pragma omp parallel for schedule(static) reduction(best_index : iteration_best)
+                for (int w = first; w < first + population; ++w) {
+                    const double* position = pack.position(w);
+                    if constexpr (separable) {
+                        pack.fitness(w) = objective.partial(Span<const double>(position, width), offset);
+                    } else {
+                        std::vector<double>& copy = workspace.scratch[thread_index()];
+                        std::copy(position, position + width, copy.begin() + offset);
+                        pack.fitness(w) = objective(Span<const double>(copy));
+                    }
+                    iteration_best = better(iteration_best, BestIndex{ pack.fitness(w), w });
+                }
+                local_stats.evaluations += population;
+                local_stats.iterations += 1;
+                if (timed) local_stats.evaluation_seconds += seconds_since(evaluation_start);
+                GWO_PROFILE_COUNT(ProfileCounter::evaluations, population);
+                GWO_PROFILE_COUNT(ProfileCounter::iterations, 1);
+
+                // A better wolf becomes the context's block
+                GWO_PROFILE_PHASE(ProfilePhase::best_update);
+                if (iteration_best.fitness < incumbent) {
+                    const double* position = pack.position(iteration_best.index);
+                    std::copy(position, position + width, context.begin() + offset);
+                    incumbent = iteration_best.fitness;
+                    if constexpr (separable) {
+                        block_terms[k] = incumbent;
+                        best_fitness = rest + incumbent;
+                    } else {
+                        best_fitness = incumbent;
+                    }
+                    GWO_PROFILE_COUNT(ProfileCounter::improvements, 1);
+                }
+
+                GWO_PROFILE_PHASE(ProfilePhase::stopping);
+                auto diversity = [&] {
+                    return rows_diversity(pack, first, population, width, lower + offset, upper + offset,
+                                          workspace.centroid);
+                };
+                if (monitor.should_stop(best_fitness, diversity, local_stats.stop_reason)) {
+                    stopped = true;
+                    break;
+                }
+
+                // Get the three best wolves (leaders) of the sub-pack
+                GWO_PROFILE_PHASE(ProfilePhase::leader_selection);
+                std::iota(order.begin(), order.end(), first);
+                std::partial_sort(order.begin(), order.begin() + 3, order.end(),
+                    [&pack](int lhs, int rhs) {
+                        return pack.fitness(lhs) < pack.fitness(rhs)
+                            || (pack.fitness(lhs) == pack.fitness(rhs) && lhs < rhs);
+                    });
+                GWO_PROFILE_PHASE(ProfilePhase::leader_copy);
+                for (int l = 0; l < 3; ++l) {
+                    pack.copy_to(order[l], leaders, l);
+                }
+                LeaderPositions leader_positions = { leaders.position(0), leaders.position(1), leaders.position(2) };
+                double a = schedule(total_iterations, cycle * block_iterations + t);
+
+                // Update positions within the block's bounds
+                GWO_PROFILE_PHASE(ProfilePhase::update);
+                Clock::time_point update_start;
+                if (timed) update_start = Clock::now();
+
+                #pragma omp parallel for schedule(static)
+                for (int w = first; w < first + population; ++w) {
+                    update_wolf(pack.position(w), leader_positions, lower + offset, upper + offset, width, a,
+                                streams[w]);
+                }
+                if (timed) local_stats.update_seconds += seconds_since(update_start);
+            }
+
+            if constexpr (separable) {
+                // Sums the terms again once per turn, so rounding does not build up in best_fitness
+                best_fitness = std::accumulate(block_terms.begin(), block_terms.end(), 0.0);
+            } else {
+                // The copies hold the last evaluated wolf in this block; restore the context's
+                for (std::vector<double>& copy : workspace.scratch) {
+                    std::copy(context.begin() + offset, context.begin() + offset + width, copy.begin() + offset);
+                }
+            }
+        }
+    }
+    GWO_PROFILE_PHASE(ProfilePhase::none);
+
+    if (stats != nullptr) {
+        *stats = local_stats;
+    }
+
+    return { Span<const double>(context), best_fitness };
+}
+
+/**
+ * @brief Same as above, running in a temporary workspace and returning a copy of the context.
+ */
+template <typename Objective, typename Schedule = LinearSchedule>
+std::pair<std::vector<double>, double> GreyWolfOptimizerCooperative(
+    const Objective& objective,
+    const std::vector<double>& lowerbound,
+    const std::vector<double>& upperbound,
+    std::size_t block_size, int population, int cycles, int block_iterations, std::uint64_t seed,
+    const Schedule& schedule = Schedule(),
+    GwoStats* stats = nullptr,
+    const StoppingCriteria& criteria = StoppingCriteria())
+{
+    CooperativeGwoWorkspace workspace;
+    auto [context, fitness] = GreyWolfOptimizerCooperative(workspace, objective, lowerbound, upperbound,
+                                                           block_size, population, cycles, block_iterations,
+                                                           seed, schedule, stats, criteria);
+    return { std::vector<double>(context.begin(), context.end()), fitness };
+}
+
+#endif // COOPERATIVE_GWO_HPP
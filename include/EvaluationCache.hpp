@@ -0,0 +1,110 @@
+#ifndef EVALUATION_CACHE_HPP
+#define EVALUATION_CACHE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Span.hpp"
+
+/**
+ * @brief Counters of an `EvaluationCache`.
+ */
+struct EvaluationCacheStats {
+    long long hits = 0;       ///< Lookups answered from the cache, i.e. objective calls saved.
+    long long misses = 0;     ///< Lookups that had to call the objective.
+    long long bypassed = 0;   ///< Positions that could not be quantized (non-finite or too large).
+    long long evictions = 0;  ///< Entries dropped to respect the capacity.
+    std::size_t size = 0;     ///< Entries currently stored.
+
+    double hit_rate() const {
+        long long lookups = hits + misses;
+        return lookups == 0 ? 0.0 : static_cast<double>(hits) / lookups;
+    }
+};
+
+/**
+ * @brief Thread-safe cache of objective values, keyed on quantized positions.
+ *
+ * Every coordinate is rounded to the nearest multiple of `tolerance`, and positions
+ * that round to the same grid point share one entry, so with `tolerance` 0 only
+ * identical positions do. Two positions closer than `tolerance` may still fall on
+ * different grid points and miss each other.
+ *
+ * The map is split into shards, each with its own mutex and least-recently-used list,
+ * so threads evaluating different positions rarely contend. When a shard is full, its
+ * least recently used entry is evicted. Two threads missing on the same position at
+ * the same time both evaluate it.
+ */
+class EvaluationCache {
+public:
+    /**
+     * @param tolerance The quantization step of every coordinate; 0 for exact matches.
+     * @param capacity The maximum number of entries, split evenly over the shards.
+     * @param shards The number of independently locked shards.
+     */
+    explicit EvaluationCache(double tolerance = 0.0, std::size_t capacity = 1 << 20, std::size_t shards = 64);
+
+    EvaluationCache(const EvaluationCache&) = delete;
+    EvaluationCache& operator=(const EvaluationCache&) = delete;
+
+    /**
+     * @brief Returns the cached value for `position`, calling `evaluate` and storing
+     *        its result on a miss.
+     *
+     * `evaluate` is called without any lock held, and may itself look up this cache
+     * or another one, for example an objective built on other cached objectives.
+     */
+    double get_or_evaluate(Span<const double> position, const std::function<double()>& evaluate);
+
+    /// Drops every entry; the counters are kept.
+    void clear();
+
+    EvaluationCacheStats stats() const;
+
+    double tolerance() const { return tolerance_; }
+    std::size_t capacity() const { return shard_capacity_ * shards_.size(); }
+
+private:
+    using Key = std::vector<std::int64_t>;
+
+    struct KeyHash {
+        std::size_t operator()(const Key& key) const;
+    };
+
+    struct Shard {
+        std::mutex mutex;
+        std::list<std::pair<Key, double>> entries;  ///< Most recently used first.
+        std::unordered_map<Key, std::list<std::pair<Key, double>>::iterator, KeyHash> index;
+    };
+
+    bool quantize(Span<const double> position, Key& key) const;
+    Shard& shard_of(const Key& key);
+
+    double tolerance_;
+    std::size_t shard_capacity_;
+    std::vector<std::unique_ptr<Shard>> shards_;
+
+    std::atomic<long long> hits_{0};
+    std::atomic<long long> misses_{0};
+    std::atomic<long long> bypassed_{0};
+    std::atomic<long long> evictions_{0};
+};
+
+/**
+ * @brief Wraps a per-point objective so that its values are looked up in `cache` first.
+ *
+ * The result can be passed to any of the optimizers; `cache` must outlive it. Reading
+ * `cache.stats()` after a run shows how many objective calls were saved.
+ */
+std::function<double(const std::vector<double>&)> make_cached_objective(
+    std::function<double(const std::vector<double>&)> function, EvaluationCache& cache);
+
+#endif // EVALUATION_CACHE_HPP
@@ -0,0 +1,281 @@
+#ifndef FIXED_GWO_HPP
+#define FIXED_GWO_HPP
+
+#include <array>
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <limits>
+#include <stdexcept>
+#include <cmath>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+#include "GWOCore.hpp"
+#include "Random.hpp"
+#include "StoppingCriteria.hpp"
+
+/**
+ * @brief Reusable buffers for `GreyWolfOptimizerFixed`.
+ *
+ * The positions are `std::array`s stored inline in one vector, so the pack is a single
+ * contiguous block with no per-wolf allocation and every loop over the coordinates
+ * has a compile-time trip count. As for `GwoWorkspace`, buffers only grow.
+ */
+template <std::size_t Dim>
+struct FixedGwoWorkspace {
+    std::vector<std::array<double, Dim>> pack;
+    std::vector<double> fitness;
+    std::vector<int> order;          ///< Wolf indices, partially sorted by fitness.
+    std::vector<VectorRng> streams;  ///< One random stream per wolf.
+
+    /// Sizes every buffer for a run and seeds the random streams.
+    void prepare(std::size_t population, std::uint64_t seed) {
+        pack.resize(population);
+        fitness.resize(population);
+        order.resize(population);
+        make_streams(seed, population, streams);
+    }
+};
+
+namespace gwo_detail {
+
+// Objectives defined for one dimension only declare it as `fixed_dimension`
+template <typename Objective, typename = void>
+constexpr bool has_fixed_dimension = false;
+
+template <typename Objective>
+constexpr bool has_fixed_dimension<Objective, std::void_t<decltype(Objective::fixed_dimension)>> = true;
+
+// Objectives whose dimension is set at construction report it through `dimension()`
+template <typename Objective, typename = void>
+constexpr bool has_runtime_dimension = false;
+
+template <typename Objective>
+constexpr bool has_runtime_dimension<Objective, std::void_t<decltype(std::declval<const Objective&>().dimension())>>
+    = true;
+
+// The same diversity as `pack_diversity`, on a fixed-dimension pack
+template <std::size_t Dim>
+double fixed_pack_diversity(const std::vector<std::array<double, Dim>>& pack,
+                            const std::array<double, Dim>& lowerbound, const std::array<double, Dim>& upperbound) {
+    const std::size_t population = pack.size();
+    if (population == 0) return 0.0;
+
+    std::array<double, Dim> mean{};
+    for (const std::array<double, Dim>& position : pack) {
+        for (std::size_t j = 0; j < Dim; ++j) {
+            mean[j] += position[j];
+        }
+    }
+    for (std::size_t j = 0; j < Dim; ++j) {
+        mean[j] /= population;
+    }
+
+    double diversity = 0.0;
+    for (std::size_t j = 0; j < Dim; ++j) {
+        double variance = 0.0;
+        for (const std::array<double, Dim>& position : pack) {
+            double deviation = position[j] - mean[j];
+            variance += deviation * deviation;
+        }
+        double width = upperbound[j] - lowerbound[j];
+        diversity += width > 0.0 ? std::sqrt(variance / population) / width : 0.0;
+    }
+    return diversity / Dim;
+}
+
+// The update of `update_wolf`, with the coefficients laid out as in one of its blocks.
+// UpdateKernel.cpp is built with -ffp-contract=off, so this copy must not be contracted
+// to FMA either, or the two optimizers would round differently on FMA machines.
+template <std::size_t Dim>
+#if defined(__GNUC__) && !defined(__clang__)
+__attribute__((optimize("fp-contract=off")))
+#endif
+inline void update_fixed_wolf(std::array<double, Dim>& position, const std::array<double, Dim> (&leaders)[3],
+                              const std::array<double, Dim>& lower, const std::array<double, Dim>& upper,
+                              double a, VectorRng& rng) {
+#ifdef __clang__
+    #pragma clang fp contract(off)
+#endif
+    std::array<double, 6 * Dim> random;
+    rng.fill_uniform(random.data(), random.size());
+
+    auto pull = [a](double wolf_pos, double leader_pos, double r1, double r2) {
+        double A = 2 * a * r1 - a;
+        double C = 2 * r2;
+        double D = std::fabs(C * leader_pos - wolf_pos);
+        return leader_pos - A * D;
+    };
+    for (std::size_t j = 0; j < Dim; ++j) {
+        double X1 = pull(position[j], leaders[0][j], random[j], random[Dim + j]);               // Alpha
+        double X2 = pull(position[j], leaders[1][j], random[2 * Dim + j], random[3 * Dim + j]); // Beta
+        double X3 = pull(position[j], leaders[2][j], random[4 * Dim + j], random[5 * Dim + j]); // Delta
+        position[j] = std::clamp((X1 + X2 + X3) / 3, lower[j], upper[j]);
+    }
+}
+
+} // namespace gwo_detail
+
+/**
+ * @brief Grey Wolf Optimizer specialized for a dimension known at compile time.
+ *
+ * For low-dimensional problems, where the cost of a run is dominated by per-call and
+ * per-wolf overhead rather than arithmetic. Positions are `std::array<double, Dim>`
+ * stored inline in the pack, the coordinate loops are fully unrolled, no OpenMP team is
+ * started, and the objective is called with the array itself:
+ * - objectives with a `fixed_dimension` (the 2-D functors of functions.hpp) are checked
+ *   against `Dim` at compile time and evaluate without any runtime size check;
+ * - objectives with a `dimension()` (Langermann, Shekel) are checked once per run;
+ * - any other objective taking a `Span<const double>` is called on a view of the array.
+ *
+ * The run is serial, on the calling thread; run several problems at once to use more
+ * cores. With the same seed it gives the same result as `GreyWolfOptimizerT`, also on
+ * CPUs with FMA: the update is never contracted. Phase timings are only measured when
+ * `stats` is not null. Checkpoints and observers are not supported.
+ *
+ * @param workspace The buffers to run in; see `FixedGwoWorkspace`.
+ * @param objective The objective to minimize.
+ * @param lowerbound The lower bound of each dimension of the search space.
+ * @param upperbound The upper bound of each dimension of the search space.
+ * @param population The number of wolves in the pack, at least 3.
+ * @param iter The number of iterations (generations) to run.
+ * @param seed The seed of the per-wolf random streams.
+ * @param schedule A callable `double(int iter, int current_iter)` giving the value of `a`.
+ * @param stats If not null, receives the evaluation and iteration counts, the phase
+ *              timings and the reason the run stopped.
+ * @param criteria Conditions that end the run early; see `StoppingCriteria`.
+ *
+ * @return The best position found and its fitness.
+ *
+ * @throws std::invalid_argument if the population is below 3 or the objective's
+ *         `dimension()` is not `Dim`.
+ */
+template <std::size_t Dim, typename Objective, typename Schedule = LinearSchedule>
+std::pair<std::array<double, Dim>, double> GreyWolfOptimizerFixed(
+    FixedGwoWorkspace<Dim>& workspace,
+    const Objective& objective,
+    const std::array<double, Dim>& lowerbound,
+    const std::array<double, Dim>& upperbound,
+    int population, int iter, std::uint64_t seed,
+    const Schedule& schedule = Schedule(),
+    GwoStats* stats = nullptr,
+    const StoppingCriteria& criteria = StoppingCriteria())
+{
+    static_assert(Dim > 0, "The dimension must be at least 1");
+    static_assert(std::is_invocable_r_v<double, const Objective&, const std::array<double, Dim>&>,
+                  "The objective must be callable with const std::array<double, Dim>& or Span<const double>");
+
+    using namespace gwo_detail;
+
+    if constexpr (has_fixed_dimension<Objective>) {
+        static_assert(Objective::fixed_dimension == Dim, "The objective is defined for another dimension");
+    } else if constexpr (has_runtime_dimension<Objective>) {
+        if (objective.dimension() != Dim) {
+            throw std::invalid_argument("The objective is defined for another dimension.");
+        }
+    }
+    if (population < 3) {
+        throw std::invalid_argument("The pack needs at least 3 wolves.");
+    }
+
+    auto run_start = Clock::now();
+    workspace.prepare(population, seed);
+
+    std::vector<std::array<double, Dim>>& pack = workspace.pack;
+    std::vector<double>& fitness = workspace.fitness;
+    std::vector<int>& order = workspace.order;
+    std::vector<VectorRng>& streams = workspace.streams;
+
+    // Initialize wolves randomly
+    for (int w = 0; w < population; ++w) {
+        std::array<double, Dim>& position = pack[w];
+        streams[w].fill_uniform(position.data(), Dim);
+        for (std::size_t j = 0; j < Dim; ++j) {
+            position[j] = lowerbound[j] + position[j] * (upperbound[j] - lowerbound[j]);
+        }
+    }
+
+    std::array<double, Dim> best_position = pack[0];
+    double best_fitness = std::numeric_limits<double>::max();
+    std::array<double, Dim> leaders[3];  // Alpha, Beta and Delta Wolves
+
+    GwoStats local_stats;
+    StopMonitor monitor(criteria, run_start);
+    const bool timed = stats != nullptr;
+
+    for (int i = 0; i < iter; ++i) {
+        if (monitor.budget_exhausted(local_stats, population)) {
+            local_stats.stop_reason = StopReason::max_evaluations;
+            break;
+        }
+
+        // Evaluate fitness
+        Clock::time_point evaluation_start;
+        if (timed) evaluation_start = Clock::now();
+        BestIndex iteration_best;
+        for (int w = 0; w < population; ++w) {
+            fitness[w] = objective(pack[w]);
+            iteration_best = better(iteration_best, BestIndex{ fitness[w], w });
+        }
+        local_stats.evaluations += population;
+        if (timed) local_stats.evaluation_seconds += seconds_since(evaluation_start);
+
+        if (iteration_best.fitness < best_fitness) {
+            best_fitness = iteration_best.fitness;
+            best_position = pack[iteration_best.index];
+        }
+        local_stats.iterations += 1;
+
+        auto diversity = [&] { return fixed_pack_diversity(pack, lowerbound, upperbound); };
+        if (monitor.should_stop(best_fitness, diversity, local_stats.stop_reason)) {
+            break;
+        }
+
+        // Get the three best wolves (leaders), ordered as in `GreyWolfOptimizerT`
+        std::iota(order.begin(), order.end(), 0);
+        std::partial_sort(order.begin(), order.begin() + 3, order.end(),
+            [&fitness](int lhs, int rhs) {
+                return fitness[lhs] < fitness[rhs] || (fitness[lhs] == fitness[rhs] && lhs < rhs);
+            });
+        for (int k = 0; k < 3; ++k) {
+            leaders[k] = pack[order[k]];
+        }
+        double a = schedule(iter, i);
+
+        // Update positions
+        Clock::time_point update_start;
+        if (timed) update_start = Clock::now();
+        for (int w = 0; w < population; ++w) {
+            update_fixed_wolf(pack[w], leaders, lowerbound, upperbound, a, streams[w]);
+        }
+        if (timed) local_stats.update_seconds += seconds_since(update_start);
+    }
+
+    if (stats != nullptr) {
+        *stats = local_stats;
+    }
+
+    return { best_position, best_fitness };
+}
+
+/**
+ * @brief Same as above, running in a temporary workspace.
+ */
+template <std::size_t Dim, typename Objective, typename Schedule = LinearSchedule>
+std::pair<std::array<double, Dim>, double> GreyWolfOptimizerFixed(
+    const Objective& objective,
+    const std::array<double, Dim>& lowerbound,
+    const std::array<double, Dim>& upperbound,
+    int population, int iter, std::uint64_t seed,
+    const Schedule& schedule = Schedule(),
+    GwoStats* stats = nullptr,
+    const StoppingCriteria& criteria = StoppingCriteria())
+{
+    FixedGwoWorkspace<Dim> workspace;
+    return GreyWolfOptimizerFixed(workspace, objective, lowerbound, upperbound, population, iter, seed,
+                                  schedule, stats, criteria);
+}
+
+#endif // FIXED_GWO_HPP
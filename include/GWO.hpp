@@ -6,8 +6,14 @@
 #include <random>
 #include <limits>
 #include <algorithm>
+#include <cstdint>
 
-// Wolf struct representing an individual in the population
+#include "BatchObjective.hpp"
+#include "GWOCore.hpp"
+
+// Wolf struct representing an individual in the population.
+// The optimizer itself stores the pack as a contiguous `Pack` (see Pack.hpp);
+// `Wolf` remains as a standalone, self-owning representation of one solution.
 struct Wolf {
     std::vector<double> position;
     double fitness;
@@ -30,6 +36,20 @@ struct Wolf {
  */
 double compute_a(int iter, int current_iter);
 
+// The functions below are the runtime-polymorphic interface: thin wrappers that
+// instantiate `GreyWolfOptimizerT` (see GWOCore.hpp) with `std::function` arguments.
+// Use `GreyWolfOptimizerT` directly to let the objective and schedule be inlined.
+
+/**
+ * @brief Scalar reference for the influence of one leader on one coordinate of a wolf.
+ *
+ * Draws `r1` and `r2` from `gen` and returns `leader_pos - A * |C * leader_pos - wolf_pos|`
+ * with `A = 2 * a * r1 - a` and `C = 2 * r2`. The optimizer itself uses the vectorized
+ * `update_wolf` (see UpdateKernel.hpp); this function is kept as the reference the
+ * kernels are benchmarked against.
+ */
+double update_position(double wolf_pos, double leader_pos, double a, std::mt19937& gen);
+
 // The main Grey Wolf Optimizer function
 /**
  * @brief Grey Wolf Optimizer (GWO) for solving optimization problems.
@@ -48,8 +68,8 @@ double compute_a(int iter, int current_iter);
  * @param upperbound A vector containing the upper bounds for each dimension of the search space.
  * @param population The number of wolves in the pack.
  * @param iter The number of iterations (generations) to run the optimization process.
- * @param gen A random number generator (std::mt19937) used for generating random values in 
- *            the update process and initializing the wolves' positions.
+ * @param gen A random number generator (std::mt19937); two values are drawn from it to seed
+ *            the per-wolf streams used for initialization and the update process.
  * @param compute_a A function that computes the parameter `a` (which influences exploration 
  *                  and exploitation) based on the current iteration and total iterations. 
  *                  Default is the provided `compute_a` function.
@@ -68,4 +88,59 @@ std::pair<std::vector<double>, double> GreyWolfOptimizer(
     int population, int iter, std::mt19937& gen, 
     const std::function<double(int, int)>& compute_a = compute_a);
 
+/**
+ * @brief Reproducible Grey Wolf Optimizer seeded with a 64-bit value.
+ *
+ * Each wolf draws its random numbers from its own jump-ahead xoshiro stream
+ * (see `make_streams`), so both the fitness evaluation and the position update run
+ * in parallel and a given seed yields bit-identical results for any number of
+ * OpenMP threads, provided `function` itself is deterministic and thread-safe.
+ *
+ * @param seed The seed of the per-wolf random streams.
+ * @param stats If not null, receives the evaluation and iteration counts, the phase
+ *              timings and the reason the run stopped.
+ * @param criteria Conditions that end the run before `iter` iterations; see `StoppingCriteria`.
+ * @param checkpointer If not null, resumes the run from its file and saves it periodically;
+ *                     see `Checkpointer`.
+ * @param observer If not empty, called with an `IterationSample` after every iteration;
+ *                 see `TelemetryStream` for writing them to a file.
+ *
+ * The remaining parameters and the return value are the same as for the overload
+ * taking a `std::mt19937`.
+ */
+std::pair<std::vector<double>, double> GreyWolfOptimizer(
+    const std::function<double(const std::vector<double>&)>& function,
+    const std::vector<double>& lowerbound,
+    const std::vector<double>& upperbound,
+    int population, int iter, std::uint64_t seed,
+    const std::function<double(int, int)>& compute_a = compute_a,
+    GwoStats* stats = nullptr,
+    const StoppingCriteria& criteria = StoppingCriteria(),
+    Checkpointer* checkpointer = nullptr,
+    const std::function<void(const IterationSample&)>& observer = nullptr);
+
+/**
+ * @brief Grey Wolf Optimizer driven by an objective that evaluates the whole pack at once.
+ *
+ * Identical to the seeded `GreyWolfOptimizer`, except that every iteration calls
+ * `objective` once with the positions of the entire pack (see `PopulationView`)
+ * instead of calling a per-point function once per wolf. Per-point functions can be
+ * passed through `make_batch_objective`. Since the objective manages its own
+ * parallelism, `stats->evaluation_wait_seconds` is not measured on this path.
+ *
+ * @param objective The batch objective; see `BatchObjective`.
+ *
+ * The remaining parameters and the return value are the same as for `GreyWolfOptimizer`.
+ */
+std::pair<std::vector<double>, double> GreyWolfOptimizerBatch(
+    const BatchObjective& objective,
+    const std::vector<double>& lowerbound,
+    const std::vector<double>& upperbound,
+    int population, int iter, std::uint64_t seed,
+    const std::function<double(int, int)>& compute_a = compute_a,
+    GwoStats* stats = nullptr,
+    const StoppingCriteria& criteria = StoppingCriteria(),
+    Checkpointer* checkpointer = nullptr,
+    const std::function<void(const IterationSample&)>& observer = nullptr);
+
 #endif // GWO_HPP
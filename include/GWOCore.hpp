@@ -0,0 +1,742 @@
+#ifndef GWO_CORE_HPP
+#define GWO_CORE_HPP
+
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <limits>
+#include <stdexcept>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "BatchObjective.hpp"
+#include "Checkpoint.hpp"
+#include "Numa.hpp"
+#include "Pack.hpp"
+#include "Profiler.hpp"
+#include "Random.hpp"
+#include "Span.hpp"
+#include "StoppingCriteria.hpp"
+#include "Telemetry.hpp"
+#include "UpdateKernel.hpp"
+
+/**
+ * @brief Counters describing where a run of the optimizer spent its time.
+ */
+struct GwoStats {
+    long long evaluations = 0;           ///< Number of objective function calls.
+    double evaluation_seconds = 0.0;     ///< Wall time of the fitness evaluation phases.
+    double evaluation_wait_seconds = 0.0;///< Thread time lost in those phases to contention and load imbalance.
+    double update_seconds = 0.0;         ///< Wall time of the position update phases.
+    int iterations = 0;                  ///< Number of iterations whose pack was evaluated.
+    StopReason stop_reason = StopReason::iterations; ///< Why the run stopped.
+};
+
+/**
+ * @brief The standard `a` schedule: starts at 2 and decreases linearly to 0.
+ */
+struct LinearSchedule {
+    double operator()(int iter, int current_iter) const {
+        return 2.0 * (1 - static_cast<double>(current_iter) / iter);
+    }
+};
+
+/**
+ * @brief Reusable buffers for `GreyWolfOptimizerT`.
+ *
+ * Holds the pack, the leaders, the per-wolf random streams, the best position and
+ * the per-thread scratch rows. Buffers only grow, so once a workspace has been used
+ * for a problem of a given size, further runs of the same or a smaller size perform
+ * no heap allocations. A workspace must not be used by two runs at the same time.
+ *
+ * Setting `placement` (see `pin_threads`) turns on the NUMA-aware mode. The rows of
+ * the pack and the scratch rows are first written by the threads that use them, so
+ * they are placed on those threads' nodes. Each node also gets its own copy of the
+ * leaders, refreshed by one of its threads every iteration. The wolves are split
+ * among threads by the same static schedule in every loop, so each thread keeps the
+ * same wolves for the whole run. The mode applies to teams of `placement->threads()`
+ * threads, as `pin_threads` sets up; with another team size the leaders are shared.
+ *
+ * @tparam Scalar The type the positions are stored and moved in. `double` is the
+ *                default; with `float` (see `FloatGwoWorkspace`) the pack takes half
+ *                the memory and the position update processes twice as many
+ *                coordinates per vector. Fitness values are doubles in both cases.
+ */
+template <typename Scalar>
+struct BasicGwoWorkspace {
+    BasicPack<Scalar> pack;
+    BasicPack<Scalar> leaders;                 ///< Copies of the alpha, beta and delta wolves.
+    std::vector<int> order;                    ///< Wolf indices, partially sorted by fitness.
+    std::vector<VectorRng> streams;            ///< One random stream per wolf.
+    std::vector<Scalar> best_position;
+    std::vector<Scalar> lower;                 ///< The bounds in `Scalar`, when it is not double.
+    std::vector<Scalar> upper;
+    std::vector<double> centroid;              ///< Mean position, for diversity and telemetry.
+    GwoCheckpoint checkpoint;                  ///< Snapshot of the run, when checkpointing.
+    std::vector<std::vector<double>> scratch;  ///< Per-thread rows for std::vector objectives.
+    const ThreadPlacement* placement = nullptr;///< Where the threads run, for the NUMA-aware mode.
+    std::vector<BasicPack<Scalar>> leader_replicas; ///< One copy of the leaders per node, in the NUMA-aware mode.
+
+    /// Sizes every buffer for a run and seeds the random streams.
+    void prepare(std::size_t population, std::size_t dimension, std::uint64_t seed) {
+        const bool numa = placement != nullptr;
+        if (numa != numa_placed_) {
+            // Pages keep the node they were first written on, so start from fresh buffers
+            pack = BasicPack<Scalar>();
+            scratch.clear();
+            leader_replicas.clear();
+            numa_placed_ = numa;
+        }
+
+        pack.resize(population, dimension, numa);
+        leaders.resize(3, dimension);
+        order.resize(population);
+        make_streams(seed, population, streams);
+        best_position.resize(dimension);
+        centroid.resize(dimension);
+
+        std::size_t threads = 1;
+#ifdef _OPENMP
+        threads = static_cast<std::size_t>(omp_get_max_threads());
+#endif
+        if (scratch.size() < threads) {
+            scratch.resize(threads);
+        }
+        if (!numa) {
+            for (std::vector<double>& row : scratch) {
+                row.resize(dimension);
+            }
+            return;
+        }
+
+        // Each thread grows its own scratch row, and the first thread of each node that node's leaders
+        if (leader_replicas.size() < static_cast<std::size_t>(placement->node_count)) {
+            leader_replicas.resize(placement->node_count);
+        }
+        const ThreadPlacement& threads_placement = *placement;
+        #pragma omp parallel
+        {
+#ifdef _OPENMP
+            const std::size_t t = static_cast<std::size_t>(omp_get_thread_num());
+#else
+            const std::size_t t = 0;
+#endif
+            if (t < scratch.size()) {
+                scratch[t].resize(dimension);
+            }
+            if (t < static_cast<std::size_t>(threads_placement.threads())
+                && threads_placement.node_leaders[threads_placement.nodes[t]] == static_cast<int>(t)) {
+                leader_replicas[threads_placement.nodes[t]].resize(3, dimension);
+            }
+        }
+        // Rows no thread of this team owns, and replicas of nodes without a thread in it
+        for (std::vector<double>& row : scratch) {
+            row.resize(dimension);
+        }
+        for (BasicPack<Scalar>& replica : leader_replicas) {
+            replica.resize(3, dimension);
+        }
+    }
+
+private:
+    bool numa_placed_ = false;  ///< Whether the buffers were first written in the NUMA-aware mode.
+};
+
+/// The double-precision workspace.
+using GwoWorkspace = BasicGwoWorkspace<double>;
+
+/// Workspace of single-precision runs: positions, bounds and update in float, fitness in double.
+using FloatGwoWorkspace = BasicGwoWorkspace<float>;
+
+namespace gwo_detail {
+
+inline int thread_index() {
+#ifdef _OPENMP
+    return omp_get_thread_num();
+#else
+    return 0;
+#endif
+}
+
+using Clock = std::chrono::steady_clock;
+
+inline double seconds_since(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// Candidate for the best wolf of an iteration; ties go to the lowest index
+struct BestIndex {
+    double fitness = std::numeric_limits<double>::max();
+    int index = std::numeric_limits<int>::max();
+};
+
+inline BestIndex better(const BestIndex& lhs, const BestIndex& rhs) {
+    if (rhs.fitness < lhs.fitness || (rhs.fitness == lhs.fitness && rhs.index < lhs.index)) {
+        return rhs;
+    }
+    return lhs;
+}
+
+#pragma omp declare reduction(best_index : BestIndex : omp_out = better(omp_out, omp_in))
+
+// Whether the current team is the one `placement` describes, so each of its nodes has a
+// thread to refresh the node's leaders. The same for every thread of the team.
+inline bool placement_matches_team(const ThreadPlacement* placement) {
+    if (placement == nullptr) return false;
+#ifdef _OPENMP
+    return omp_get_num_threads() == placement->threads();
+#else
+    return placement->threads() == 1;
+#endif
+}
+
+// How an objective is called, decided at compile time from its signature and the
+// type of the positions
+template <typename Objective, typename Scalar = double>
+constexpr bool is_batch_objective
+    = std::is_invocable_v<const Objective&, const BasicPopulationView<Scalar>&, Span<double>>;
+
+template <typename Objective, typename Scalar = double>
+constexpr bool is_span_objective = !is_batch_objective<Objective, Scalar>
+    && std::is_invocable_r_v<double, const Objective&, Span<const Scalar>>;
+
+template <typename Objective, typename Scalar = double>
+constexpr bool is_vector_objective = !is_batch_objective<Objective, Scalar> && !is_span_objective<Objective, Scalar>
+    && std::is_invocable_r_v<double, const Objective&, const std::vector<double>&>;
+
+// Bounds rounded to `Scalar`, each rounded inwards if needed, so a clamped coordinate
+// never leaves the double-precision domain
+template <typename Scalar>
+void narrow_bounds(const std::vector<double>& lowerbound, const std::vector<double>& upperbound,
+                   std::vector<Scalar>& lower, std::vector<Scalar>& upper) {
+    lower.resize(lowerbound.size());
+    upper.resize(upperbound.size());
+    for (std::size_t j = 0; j < lowerbound.size(); ++j) {
+        lower[j] = static_cast<Scalar>(lowerbound[j]);
+        upper[j] = static_cast<Scalar>(upperbound[j]);
+        if (lower[j] < lowerbound[j]) lower[j] = std::nextafter(lower[j], std::numeric_limits<Scalar>::infinity());
+        if (upper[j] > upperbound[j]) upper[j] = std::nextafter(upper[j], -std::numeric_limits<Scalar>::infinity());
+    }
+}
+
+// Evaluates every wolf with a per-point objective. Each thread keeps its own best
+// index and the reduction combines them, so the loop has no critical section.
+template <typename Objective, typename Scalar>
+BestIndex evaluate_pointwise(const Objective& objective, BasicPack<Scalar>& pack,
+                             std::vector<std::vector<double>>& scratch_rows, GwoStats& stats) {
+    const int population = static_cast<int>(pack.population());
+    const std::size_t dimension = pack.dimension();
+
+    BestIndex iteration_best;
+    double busy_seconds = 0.0;
+    int team_size = 0;
+    auto phase_start = Clock::now();
+    GWO_PROFILE_TEAM(team);
+
+    #pragma omp parallel reduction(best_index : iteration_best) reduction(+ : busy_seconds, team_size)
+    {
+        GWO_PROFILE_TEAM_SCOPE(ProfilePhase::evaluation_thread, team);
+        // Objectives taking a std::vector need the row copied into one first
+        std::vector<double>& scratch = scratch_rows[thread_index()];
+        auto thread_start = Clock::now();
+
+        // Static, like the update, so every thread evaluates the wolves it updates
+        #pragma omp for schedule(static) nowait
+        for (int j = 0; j < population; ++j) {
+            const Scalar* position = pack.position(j);
+            if constexpr (is_span_objective<Objective, Scalar>) {
+                pack.fitness(j) = objective(Span<const Scalar>(position, dimension));
+            } else {
+                std::copy(position, position + dimension, scratch.begin());
+                pack.fitness(j) = objective(static_cast<const std::vector<double>&>(scratch));
+            }
+            iteration_best = better(iteration_best, BestIndex{ pack.fitness(j), j });
+        }
+
+        busy_seconds += seconds_since(thread_start);
+        team_size += 1;
+    }
+
+    double phase_seconds = seconds_since(phase_start);
+    stats.evaluations += population;
+    stats.evaluation_seconds += phase_seconds;
+    stats.evaluation_wait_seconds += std::max(0.0, phase_seconds * team_size - busy_seconds);
+    return iteration_best;
+}
+
+// Evaluates the whole pack with a single call to a batch objective
+template <typename Objective, typename Scalar>
+BestIndex evaluate_batch(const Objective& objective, BasicPack<Scalar>& pack, GwoStats& stats) {
+    const int population = static_cast<int>(pack.population());
+    BasicPopulationView<Scalar> view = { pack.positions(), pack.population(), pack.dimension(), pack.stride() };
+
+    auto phase_start = Clock::now();
+    objective(view, Span<double>(pack.fitnesses(), pack.population()));
+    stats.evaluations += population;
+    stats.evaluation_seconds += seconds_since(phase_start);
+
+    BestIndex iteration_best;
+    for (int j = 0; j < population; ++j) {
+        iteration_best = better(iteration_best, BestIndex{ pack.fitness(j), j });
+    }
+    return iteration_best;
+}
+
+// Mean over the coordinates of the standard deviation of the pack, each divided by
+// the width of its bounds. Two passes, so a pack collapsed far from the origin
+// does not lose its spread to cancellation.
+template <typename Scalar>
+double pack_diversity(const BasicPack<Scalar>& pack, const std::vector<double>& lowerbound,
+                      const std::vector<double>& upperbound, std::vector<double>& centroid) {
+    const std::size_t population = pack.population();
+    const std::size_t dimension = pack.dimension();
+    if (population == 0 || dimension == 0) return 0.0;
+
+    std::fill(centroid.begin(), centroid.end(), 0.0);
+    double* mean = centroid.data();
+    for (std::size_t w = 0; w < population; ++w) {
+        const Scalar* position = pack.position(w);
+        #pragma omp simd
+        for (std::size_t j = 0; j < dimension; ++j) {
+            mean[j] += position[j];
+        }
+    }
+    for (std::size_t j = 0; j < dimension; ++j) {
+        mean[j] /= population;
+    }
+
+    double diversity = 0.0;
+    for (std::size_t j = 0; j < dimension; ++j) {
+        double variance = 0.0;
+        for (std::size_t w = 0; w < population; ++w) {
+            double deviation = pack.position(w)[j] - mean[j];
+            variance += deviation * deviation;
+        }
+        double width = upperbound[j] - lowerbound[j];
+        diversity += width > 0.0 ? std::sqrt(variance / population) / width : 0.0;
+    }
+    return diversity / dimension;
+}
+
+// Checks the stopping criteria once per iteration and remembers the last improvement
+class StopMonitor {
+public:
+    StopMonitor(const StoppingCriteria& criteria, Clock::time_point start)
+        : criteria_(criteria), start_(start) {}
+
+    // True if the next iteration, evaluating `population` more points, must not start
+    bool budget_exhausted(const GwoStats& stats, int population) const {
+        return criteria_.max_evaluations > 0 && stats.iterations > 0
+            && stats.evaluations + population > criteria_.max_evaluations;
+    }
+
+    // Called after each evaluated iteration; returns true and sets `reason` if the run must stop.
+    // `diversity` returns the pack diversity, and is only called if there is a minimum.
+    template <typename Diversity>
+    bool should_stop(double best_fitness, const Diversity& diversity, StopReason& reason) {
+        if (best_fitness <= criteria_.target_fitness) {
+            reason = StopReason::target_fitness;
+            return true;
+        }
+        if (criteria_.stagnation_iterations > 0) {
+            if (!has_reference_ || best_fitness < reference_fitness_ - criteria_.stagnation_tolerance) {
+                reference_fitness_ = best_fitness;
+                has_reference_ = true;
+                stagnant_iterations_ = 0;
+            } else if (++stagnant_iterations_ >= criteria_.stagnation_iterations) {
+                reason = StopReason::stagnation;
+                return true;
+            }
+        }
+        if (criteria_.min_diversity > 0.0 && diversity() < criteria_.min_diversity) {
+            reason = StopReason::diversity;
+            return true;
+        }
+        if (criteria_.max_seconds < std::numeric_limits<double>::infinity()
+            && seconds_since(start_) >= criteria_.max_seconds) {
+            reason = StopReason::deadline;
+            return true;
+        }
+        return false;
+    }
+
+    void save(GwoCheckpoint& state) const {
+        state.stagnation_reference = reference_fitness_;
+        state.stagnation_started = has_reference_;
+        state.stagnant_iterations = stagnant_iterations_;
+    }
+
+    void restore(const GwoCheckpoint& state) {
+        reference_fitness_ = state.stagnation_reference;
+        has_reference_ = state.stagnation_started;
+        stagnant_iterations_ = state.stagnant_iterations;
+    }
+
+private:
+    const StoppingCriteria& criteria_;
+    Clock::time_point start_;
+    double reference_fitness_ = 0.0;
+    bool has_reference_ = false;
+    int stagnant_iterations_ = 0;
+};
+
+// Whether the optimizer reports samples to `Observer` at all
+template <typename Observer>
+constexpr bool is_observed = !std::is_same_v<Observer, NullObserver>;
+
+// The part of an iteration's sample known once the pack has been evaluated
+template <typename Scalar>
+IterationSample sample_iteration(const BasicPack<Scalar>& pack, const std::vector<double>& lowerbound,
+                                 const std::vector<double>& upperbound, std::vector<double>& centroid,
+                                 int iteration, const GwoStats& stats, double best_fitness,
+                                 double a, double evaluation_seconds) {
+    const std::size_t population = pack.population();
+    double fitness_sum = 0.0;
+    for (std::size_t w = 0; w < population; ++w) {
+        fitness_sum += pack.fitness(w);
+    }
+
+    IterationSample sample;
+    sample.iteration = iteration;
+    sample.evaluations = stats.evaluations;
+    sample.best_fitness = best_fitness;
+    sample.mean_fitness = population == 0 ? 0.0 : fitness_sum / population;
+    sample.diversity = pack_diversity(pack, lowerbound, upperbound, centroid);
+    sample.a = a;
+    sample.evaluation_seconds = evaluation_seconds;
+    return sample;
+}
+
+// Copies the state of a run about to start iteration `next_iteration` into `state`
+template <typename Scalar>
+void capture_checkpoint(GwoCheckpoint& state, const BasicPack<Scalar>& pack, const std::vector<VectorRng>& streams,
+                        const std::vector<Scalar>& best_position, double best_fitness,
+                        const GwoStats& stats, const StopMonitor& monitor,
+                        std::uint64_t seed, int iter, int next_iteration) {
+    const std::size_t population = pack.population();
+    const std::size_t dimension = pack.dimension();
+    constexpr std::size_t rng_words = 4 * VectorRng::lanes;
+
+    state.seed = seed;
+    state.population = population;
+    state.dimension = dimension;
+    state.iter = static_cast<std::uint64_t>(iter);
+    state.next_iteration = static_cast<std::uint64_t>(next_iteration);
+    state.evaluations = stats.evaluations;
+    state.iterations = stats.iterations;
+    state.best_fitness = best_fitness;
+    monitor.save(state);
+
+    state.best_position.assign(best_position.begin(), best_position.end());
+    state.positions.resize(population * dimension);
+    state.fitness.resize(population);
+    state.rng_state.resize(population * rng_words);
+    for (std::size_t w = 0; w < population; ++w) {
+        std::copy(pack.position(w), pack.position(w) + dimension, state.positions.begin() + w * dimension);
+        state.fitness[w] = pack.fitness(w);
+        const std::uint64_t* words = &streams[w].state[0][0];
+        std::copy(words, words + rng_words, state.rng_state.begin() + w * rng_words);
+    }
+}
+
+// Restores a run from `state`; returns the iteration to resume at
+template <typename Scalar>
+int restore_checkpoint(const GwoCheckpoint& state, BasicPack<Scalar>& pack, std::vector<VectorRng>& streams,
+                       std::vector<Scalar>& best_position, double& best_fitness,
+                       GwoStats& stats, StopMonitor& monitor,
+                       std::uint64_t seed, int iter) {
+    const std::size_t population = pack.population();
+    const std::size_t dimension = pack.dimension();
+    constexpr std::size_t rng_words = 4 * VectorRng::lanes;
+
+    if (state.seed != seed || state.population != population || state.dimension != dimension
+        || state.iter != static_cast<std::uint64_t>(iter)) {
+        throw std::runtime_error("The checkpoint was written by a run with another seed, population, "
+                                 "dimension or iteration count.");
+    }
+
+    for (std::size_t w = 0; w < population; ++w) {
+        std::copy(state.positions.begin() + w * dimension, state.positions.begin() + (w + 1) * dimension,
+                  pack.position(w));
+        pack.fitness(w) = state.fitness[w];
+        std::uint64_t* words = &streams[w].state[0][0];
+        std::copy(state.rng_state.begin() + w * rng_words, state.rng_state.begin() + (w + 1) * rng_words, words);
+    }
+    std::copy(state.best_position.begin(), state.best_position.end(), best_position.begin());
+    best_fitness = state.best_fitness;
+    stats.evaluations = state.evaluations;
+    stats.iterations = state.iterations;
+    monitor.restore(state);
+    return static_cast<int>(state.next_iteration);
+}
+
+} // namespace gwo_detail
+
+/**
+ * @brief Statically dispatched Grey Wolf Optimizer.
+ *
+ * Header-only core of the optimizer. Both the objective and the `a` schedule are
+ * template parameters, so they are called directly and can be inlined into the
+ * evaluation and iteration loops. How the objective is called is chosen at compile
+ * time from its signature, in this order:
+ * - `void(const PopulationView&, Span<double>)`: a batch objective, called once per iteration;
+ * - `double(Span<const double>)`: called on each row of the pack in place;
+ * - `double(const std::vector<double>&)`: called on a per-thread copy of each row.
+ *
+ * Per-point objectives are evaluated in parallel with OpenMP and must be thread-safe.
+ * Each wolf draws from its own random stream, so a given seed gives bit-identical
+ * results for any number of threads. When built with `GWO_PROFILE`, every phase of
+ * the run is recorded by the `Profiler`.
+ *
+ * All buffers come from `workspace`; once it has been sized by a first run, later
+ * runs of the same size perform no heap allocations.
+ *
+ * The type of the workspace sets the precision of the positions. With a
+ * `FloatGwoWorkspace`, per-point objectives are called with `Span<const float>` if they
+ * accept it (the functors of functions.hpp do, accumulating in double) and otherwise
+ * with a `std::vector<double>` copy; batch objectives receive a `FloatPopulationView`.
+ *
+ * @param workspace The buffers to run in; see `BasicGwoWorkspace`.
+ * @param objective The objective to minimize.
+ * @param lowerbound The lower bound of each dimension of the search space.
+ * @param upperbound The upper bound of each dimension of the search space.
+ * @param population The number of wolves in the pack, at least 3.
+ * @param iter The number of iterations (generations) to run.
+ * @param seed The seed of the per-wolf random streams.
+ * @param schedule A callable `double(int iter, int current_iter)` giving the value of `a`.
+ * @param stats If not null, receives the evaluation and iteration counts, the phase
+ *              timings and the reason the run stopped.
+ * @param criteria Conditions that end the run early; see `StoppingCriteria`.
+ * @param checkpointer If not null, the run resumes from its file when there is one, and
+ *                     saves its state every `checkpointer->interval()` iterations. The
+ *                     evaluation and iteration counts carry over; timings and the
+ *                     wall-clock budget restart with the process.
+ * @param observer Called with an `IterationSample` at the end of every iteration, for
+ *                 example a `TelemetryStream::observer`. With the default `NullObserver`
+ *                 no sample is computed.
+ *
+ * @return A view of the best position found, valid until the workspace is reused,
+ *         and its fitness.
+ *
+ * @throws std::invalid_argument if the population is below 3 or the bounds differ in size.
+ */
+template <typename Scalar, typename Objective, typename Schedule = LinearSchedule, typename Observer = NullObserver>
+std::pair<Span<const Scalar>, double> GreyWolfOptimizerT(
+    BasicGwoWorkspace<Scalar>& workspace,
+    const Objective& objective,
+    const std::vector<double>& lowerbound,
+    const std::vector<double>& upperbound,
+    int population, int iter, std::uint64_t seed,
+    const Schedule& schedule = Schedule(),
+    GwoStats* stats = nullptr,
+    const StoppingCriteria& criteria = StoppingCriteria(),
+    Checkpointer* checkpointer = nullptr,
+    Observer observer = Observer())
+{
+    static_assert(gwo_detail::is_batch_objective<Objective, Scalar> || gwo_detail::is_span_objective<Objective, Scalar>
+                  || gwo_detail::is_vector_objective<Objective, Scalar>,
+                  "The objective must be callable with (const BasicPopulationView<Scalar>&, Span<double>), "
+                  "Span<const Scalar> or const std::vector<double>&");
+
+    using namespace gwo_detail;
+
+    if (population < 3) {
+        throw std::invalid_argument("The pack needs at least 3 wolves.");
+    }
+    if (lowerbound.size() != upperbound.size()) {
+        throw std::invalid_argument("The lower and upper bounds must have the same size.");
+    }
+
+    auto run_start = Clock::now();
+    GWO_PROFILE_PHASE(ProfilePhase::initialization);
+    const std::size_t dimension = lowerbound.size();
+    workspace.prepare(population, dimension, seed);
+
+    BasicPack<Scalar>& pack = workspace.pack;
+    BasicPack<Scalar>& leaders = workspace.leaders; // Alpha, Beta and Delta Wolves
+    std::vector<int>& order = workspace.order;
+    // Every wolf owns a jump-ahead stream, so results do not depend on the thread count
+    std::vector<VectorRng>& streams = workspace.streams;
+
+    // Track the best solution found; ties within an iteration go to the lowest index
+    std::vector<Scalar>& best_position = workspace.best_position;
+    double best_fitness = std::numeric_limits<double>::max();
+
+    // The bounds as the update kernel reads them
+    const Scalar* lower;
+    const Scalar* upper;
+    if constexpr (std::is_same_v<Scalar, double>) {
+        lower = lowerbound.data();
+        upper = upperbound.data();
+    } else {
+        narrow_bounds(lowerbound, upperbound, workspace.lower, workspace.upper);
+        lower = workspace.lower.data();
+        upper = workspace.upper.data();
+    }
+
+    GwoStats local_stats;
+    StopMonitor monitor(criteria, run_start);
+
+    int first_iteration = 0;
+    if (checkpointer != nullptr && checkpointer->load(workspace.checkpoint)) {
+        first_iteration = restore_checkpoint(workspace.checkpoint, pack, streams, best_position, best_fitness,
+                                             local_stats, monitor, seed, iter);
+    } else {
+        // Initialize wolves randomly
+        #pragma omp parallel for schedule(static)
+        for (int w = 0; w < population; ++w) {
+            Scalar* position = pack.position(w);
+            streams[w].fill_uniform(position, dimension);
+            for (std::size_t j = 0; j < dimension; ++j) {
+                position[j] = lower[j] + position[j] * (upper[j] - lower[j]);
+            }
+        }
+        std::copy(pack.position(0), pack.position(0) + dimension, best_position.begin());
+    }
+
+    for (int i = first_iteration; i < iter; ++i) {
+        if (monitor.budget_exhausted(local_stats, population)) {
+            local_stats.stop_reason = StopReason::max_evaluations;
+            break;
+        }
+
+        // Evaluate fitness
+        GWO_PROFILE_PHASE(ProfilePhase::evaluation);
+        const double evaluation_start_seconds = local_stats.evaluation_seconds;
+        BestIndex iteration_best;
+        if constexpr (is_batch_objective<Objective, Scalar>) {
+            iteration_best = evaluate_batch(objective, pack, local_stats);
+        } else {
+            iteration_best = evaluate_pointwise(objective, pack, workspace.scratch, local_stats);
+        }
+        GWO_PROFILE_COUNT(ProfileCounter::evaluations, population);
+
+        // Copy the winning position once per iteration, and only if it improved
+        GWO_PROFILE_PHASE(ProfilePhase::best_update);
+        if (iteration_best.fitness < best_fitness) {
+            best_fitness = iteration_best.fitness;
+            const Scalar* position = pack.position(iteration_best.index);
+            std::copy(position, position + dimension, best_position.begin());
+            GWO_PROFILE_COUNT(ProfileCounter::improvements, 1);
+        }
+        local_stats.iterations += 1;
+        GWO_PROFILE_COUNT(ProfileCounter::iterations, 1);
+        double a = schedule(iter, i);
+
+        IterationSample sample;
+        if constexpr (is_observed<Observer>) {
+            GWO_PROFILE_PHASE(ProfilePhase::observer);
+            sample = sample_iteration(pack, lowerbound, upperbound, workspace.centroid, i, local_stats, best_fitness,
+                                      a, local_stats.evaluation_seconds - evaluation_start_seconds);
+        }
+
+        GWO_PROFILE_PHASE(ProfilePhase::stopping);
+        auto diversity = [&] { return pack_diversity(pack, lowerbound, upperbound, workspace.centroid); };
+        if (monitor.should_stop(best_fitness, diversity, local_stats.stop_reason)) {
+            if constexpr (is_observed<Observer>) {
+                GWO_PROFILE_PHASE(ProfilePhase::observer);
+                observer(sample);
+            }
+            break;
+        }
+
+        // Get the three best wolves (leaders)
+        GWO_PROFILE_PHASE(ProfilePhase::leader_selection);
+        std::iota(order.begin(), order.end(), 0);
+        std::partial_sort(order.begin(), order.begin() + 3, order.end(),
+            [&pack](int lhs, int rhs) {
+                return pack.fitness(lhs) < pack.fitness(rhs)
+                    || (pack.fitness(lhs) == pack.fitness(rhs) && lhs < rhs);
+            });
+        GWO_PROFILE_PHASE(ProfilePhase::leader_copy);
+        for (int k = 0; k < 3; ++k) {
+            pack.copy_to(order[k], leaders, k);
+        }
+
+        BasicLeaderPositions<Scalar> leader_positions = { leaders.position(0), leaders.position(1), leaders.position(2) };
+
+        // Update positions, streaming through each contiguous row of the pack
+        GWO_PROFILE_PHASE(ProfilePhase::update);
+        auto update_start = Clock::now();
+        GWO_PROFILE_TEAM(team);
+
+        #pragma omp parallel
+        {
+            GWO_PROFILE_TEAM_SCOPE(ProfilePhase::update_thread, team);
+
+            BasicLeaderPositions<Scalar> thread_leaders = leader_positions;
+            if (placement_matches_team(workspace.placement)) {
+                // One thread per node copies the leaders into memory on its node; the others read that copy
+                const ThreadPlacement& placement = *workspace.placement;
+                const int thread = thread_index();
+                BasicPack<Scalar>& replica = workspace.leader_replicas[placement.nodes[thread]];
+                if (placement.node_leaders[placement.nodes[thread]] == thread) {
+                    for (int k = 0; k < 3; ++k) {
+                        leaders.copy_to(k, replica, k);
+                    }
+                }
+                #pragma omp barrier
+                thread_leaders = { replica.position(0), replica.position(1), replica.position(2) };
+            }
+
+            #pragma omp for schedule(static) nowait
+            for (int w = 0; w < population; ++w) {
+                update_wolf(pack.position(w), thread_leaders, lower, upper, dimension, a, streams[w]);
+            }
+        }
+
+        double update_seconds = seconds_since(update_start);
+        local_stats.update_seconds += update_seconds;
+
+        if constexpr (is_observed<Observer>) {
+            GWO_PROFILE_PHASE(ProfilePhase::observer);
+            sample.update_seconds = update_seconds;
+            observer(sample);
+        }
+
+        if (checkpointer != nullptr && checkpointer->due(i + 1)) {
+            GWO_PROFILE_PHASE(ProfilePhase::checkpoint);
+            capture_checkpoint(workspace.checkpoint, pack, streams, best_position, best_fitness,
+                               local_stats, monitor, seed, iter, i + 1);
+            checkpointer->save(workspace.checkpoint);
+        }
+    }
+    GWO_PROFILE_PHASE(ProfilePhase::none);
+
+    if (stats != nullptr) {
+        *stats = local_stats;
+    }
+
+    return { Span<const Scalar>(best_position), best_fitness };
+}
+
+/**
+ * @brief Same as above, running in a temporary workspace and returning a copy of the best position.
+ */
+template <typename Objective, typename Schedule = LinearSchedule, typename Observer = NullObserver>
+std::pair<std::vector<double>, double> GreyWolfOptimizerT(
+    const Objective& objective,
+    const std::vector<double>& lowerbound,
+    const std::vector<double>& upperbound,
+    int population, int iter, std::uint64_t seed,
+    const Schedule& schedule = Schedule(),
+    GwoStats* stats = nullptr,
+    const StoppingCriteria& criteria = StoppingCriteria(),
+    Checkpointer* checkpointer = nullptr,
+    Observer observer = Observer())
+{
+    GwoWorkspace workspace;
+    auto [best_position, best_fitness] = GreyWolfOptimizerT(workspace, objective, lowerbound, upperbound,
+                                                            population, iter, seed, schedule, stats, criteria,
+                                                            checkpointer, observer);
+    return { std::vector<double>(best_position.begin(), best_position.end()), best_fitness };
+}
+
+#endif // GWO_CORE_HPP
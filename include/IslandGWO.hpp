@@ -0,0 +1,86 @@
+#ifndef ISLAND_GWO_HPP
+#define ISLAND_GWO_HPP
+
+#include <vector>
+#include <functional>
+#include <cstddef>
+#include <cstdint>
+
+#include "GWO.hpp"
+
+/**
+ * @brief Which islands send their emigrants to which.
+ */
+enum class IslandTopology {
+    ring,               ///< Island `k` sends to island `k + 1`, the last one to the first.
+    bidirectional_ring, ///< Island `k` sends to islands `k - 1` and `k + 1`.
+    fully_connected     ///< Every island sends to every other island.
+};
+
+/**
+ * @brief Layout of an island-model run and its migration policy.
+ */
+struct IslandOptions {
+    std::size_t islands = 0;      ///< Number of packs, each on its own thread; 0 uses one per hardware thread.
+    int migration_interval = 25;  ///< Iterations between two migrations; 0 disables migration.
+    int migrants = 2;             ///< Wolves each island sends along every outgoing edge.
+    IslandTopology topology = IslandTopology::ring;
+};
+
+/**
+ * @brief Counters of an island-model run.
+ */
+struct IslandStats {
+    GwoStats totals;                 ///< Summed over the islands; `iterations` is the largest of any island.
+    std::vector<double> best_fitness;///< Best fitness found by each island.
+    long long migrants_sent = 0;     ///< Wolves published to a mailbox.
+    long long migrants_accepted = 0; ///< Immigrants that replaced a worse wolf.
+};
+
+/**
+ * @brief Island-model Grey Wolf Optimizer: several independent packs exchanging their best wolves.
+ *
+ * Every island is a pack of `population` wolves with its own alpha, beta and delta and
+ * its own random streams (seeded with `derive_seed(seed, island, 0)`), run by its own
+ * thread with OpenMP limited to one thread inside it. Every `migration_interval`
+ * iterations, after its evaluation, an island:
+ * - posts copies of its `migrants` best wolves, with their fitness, to the mailbox of
+ *   each outgoing edge of the topology;
+ * - takes the latest batch from each incoming mailbox, if a new one arrived, and lets
+ *   every immigrant replace the worst wolf of the pack when it is fitter.
+ *
+ * Immigrants are placed before the leaders are selected, so a better wolf from a
+ * neighbour leads the pack at once. Mailboxes are lock-free triple buffers: a sender
+ * never waits for its receiver and the islands never synchronize, so a fast island
+ * simply reads the same batch again later or skips the batches it missed.
+ *
+ * Since what an island receives depends on timing, runs with migration enabled are
+ * not reproducible, even with a fixed seed. With `migration_interval` 0, the islands
+ * are independent runs and the result only depends on the seed.
+ *
+ * @param function The objective. It is called from the island threads and must be thread-safe.
+ * @param lowerbound The lower bound of each dimension of the search space.
+ * @param upperbound The upper bound of each dimension of the search space.
+ * @param population The number of wolves in each island; at least 3.
+ * @param iter The number of iterations every island runs.
+ * @param seed The seed from which every island derives its own.
+ * @param options The number of islands and the migration policy; see `IslandOptions`.
+ * @param compute_a The schedule of `a`, called as `compute_a(iter, current_iter)` on every island.
+ * @param stats If not null, receives the counters of the run; see `IslandStats`.
+ *
+ * @return The best position found by any island and its fitness.
+ *
+ * @throws std::invalid_argument if `population` is below 3, `migrants` is not below `population`,
+ *         or the bounds differ in size.
+ * @throws Rethrows the first exception thrown by `function`, once every island has stopped.
+ */
+std::pair<std::vector<double>, double> GreyWolfOptimizerIslands(
+    const std::function<double(const std::vector<double>&)>& function,
+    const std::vector<double>& lowerbound,
+    const std::vector<double>& upperbound,
+    int population, int iter, std::uint64_t seed,
+    const IslandOptions& options = IslandOptions(),
+    const std::function<double(int, int)>& compute_a = compute_a,
+    IslandStats* stats = nullptr);
+
+#endif // ISLAND_GWO_HPP
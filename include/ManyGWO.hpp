@@ -0,0 +1,323 @@
+#ifndef MANY_GWO_HPP
+#define MANY_GWO_HPP
+
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <limits>
+#include <stdexcept>
+#include <cmath>
+#include <cstdint>
+#include <type_traits>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "GWOCore.hpp"
+#include "Pack.hpp"
+#include "Random.hpp"
+#include "Span.hpp"
+#include "StoppingCriteria.hpp"
+#include "UpdateKernel.hpp"
+
+/// Number of problem instances solved side by side in one group, one per vector lane.
+constexpr std::size_t many_lanes = 8;
+
+/**
+ * @brief The outcome of one problem instance of `GreyWolfOptimizerMany`.
+ */
+struct InstanceResult {
+    std::vector<double> best_position;
+    double best_fitness = std::numeric_limits<double>::max();
+    GwoStats stats;  ///< Evaluation and iteration counts and stop reason; timings are not measured.
+};
+
+/**
+ * @brief The buffers of one group of `many_lanes` instances.
+ *
+ * Coordinate `j` of wolf `w` of lane `b` is `pack.position(w)[j * many_lanes + b]`, so a row
+ * of the pack holds one wolf of every instance of the group, interleaved coordinate by
+ * coordinate, and the leaders and bounds are laid out the same way.
+ */
+struct ManyGroupBuffers {
+    Pack pack;
+    Pack leaders;                      ///< Alpha, beta and delta of every lane.
+    std::vector<double> fitness;       ///< `population x many_lanes`, lane-minor.
+    std::vector<double> lower;         ///< The bounds, repeated for every lane.
+    std::vector<double> upper;
+    std::vector<int> order;            ///< Wolf indices, partially sorted by one lane's fitness.
+    std::vector<VectorRng> streams;    ///< One random stream per wolf, shared by the lanes.
+    std::vector<double> point;         ///< One lane's wolf, gathered for the objective.
+    std::vector<gwo_detail::StopMonitor> monitors; ///< One per lane.
+};
+
+/**
+ * @brief Reusable buffers for `GreyWolfOptimizerMany`: the results, and one group per thread.
+ *
+ * As for `GwoWorkspace`, buffers only grow, so a workspace reused for batches of the same
+ * size, population and dimension performs no heap allocations after the first.
+ */
+struct ManyGwoWorkspace {
+    std::vector<InstanceResult> results;
+    std::vector<ManyGroupBuffers> groups;  ///< Indexed by thread.
+
+    /// Sizes the results and the per-thread group buffers for a batch.
+    void prepare(std::size_t instances, std::size_t population, std::size_t dimension) {
+        results.resize(instances);
+        for (InstanceResult& result : results) {
+            result.best_position.resize(dimension);
+            result.best_fitness = std::numeric_limits<double>::max();
+            result.stats = GwoStats();
+        }
+
+        std::size_t threads = 1;
+#ifdef _OPENMP
+        threads = static_cast<std::size_t>(omp_get_max_threads());
+#endif
+        if (groups.size() < threads) {
+            groups.resize(threads);
+        }
+        for (ManyGroupBuffers& group : groups) {
+            group.pack.resize(population, dimension * many_lanes);
+            group.leaders.resize(3, dimension * many_lanes);
+            group.fitness.resize(population * many_lanes);
+            group.lower.resize(dimension * many_lanes);
+            group.upper.resize(dimension * many_lanes);
+            group.order.resize(population);
+            group.point.resize(dimension);
+        }
+    }
+};
+
+namespace gwo_detail {
+
+// `pack_diversity` of one lane of a group
+inline double lane_diversity(const Pack& pack, std::size_t lane, std::size_t dimension,
+                             const std::vector<double>& lowerbound, const std::vector<double>& upperbound) {
+    const std::size_t population = pack.population();
+    double diversity = 0.0;
+    for (std::size_t j = 0; j < dimension; ++j) {
+        const std::size_t column = j * many_lanes + lane;
+        double mean = 0.0;
+        for (std::size_t w = 0; w < population; ++w) {
+            mean += pack.position(w)[column];
+        }
+        mean /= population;
+
+        double variance = 0.0;
+        for (std::size_t w = 0; w < population; ++w) {
+            double deviation = pack.position(w)[column] - mean;
+            variance += deviation * deviation;
+        }
+        double width = upperbound[j] - lowerbound[j];
+        diversity += width > 0.0 ? std::sqrt(variance / population) / width : 0.0;
+    }
+    return dimension == 0 ? 0.0 : diversity / dimension;
+}
+
+// Runs instances [first, first + lanes) of the batch to completion in `group`
+template <typename Objective, typename Schedule>
+void run_many_group(ManyGroupBuffers& group, InstanceResult* results, const Objective* objectives,
+                    std::size_t lanes, const std::vector<double>& lowerbound, const std::vector<double>& upperbound,
+                    int population, int iter, std::uint64_t seed, const Schedule& schedule,
+                    const StoppingCriteria& criteria, Clock::time_point run_start) {
+    const std::size_t dimension = lowerbound.size();
+    const std::size_t width = dimension * many_lanes;
+
+    Pack& pack = group.pack;
+    Pack& leaders = group.leaders;
+    std::vector<double>& fitness = group.fitness;
+    std::vector<int>& order = group.order;
+    std::vector<double>& point = group.point;
+
+    // Padding lanes of the last group move like the others but are never evaluated
+    for (std::size_t j = 0; j < dimension; ++j) {
+        std::fill_n(group.lower.begin() + j * many_lanes, many_lanes, lowerbound[j]);
+        std::fill_n(group.upper.begin() + j * many_lanes, many_lanes, upperbound[j]);
+    }
+    const double* lower = group.lower.data();
+    const double* upper = group.upper.data();
+
+    make_streams(seed, population, group.streams);
+    group.monitors.clear();
+    bool active[many_lanes] = {};
+    for (std::size_t b = 0; b < lanes; ++b) {
+        group.monitors.emplace_back(criteria, run_start);
+        active[b] = true;
+    }
+    std::size_t active_lanes = lanes;
+
+    // Initialize wolves randomly
+    for (int w = 0; w < population; ++w) {
+        double* position = pack.position(w);
+        group.streams[w].fill_uniform(position, width);
+        for (std::size_t k = 0; k < width; ++k) {
+            position[k] = lower[k] + position[k] * (upper[k] - lower[k]);
+        }
+    }
+
+    for (int i = 0; i < iter && active_lanes > 0; ++i) {
+        for (std::size_t b = 0; b < lanes; ++b) {
+            if (!active[b]) continue;
+            InstanceResult& result = results[b];
+            StopMonitor& monitor = group.monitors[b];
+            if (monitor.budget_exhausted(result.stats, population)) {
+                result.stats.stop_reason = StopReason::max_evaluations;
+                active[b] = false;
+                --active_lanes;
+                continue;
+            }
+
+            // Evaluate fitness, gathering each wolf of the lane into a contiguous point
+            BestIndex iteration_best;
+            for (int w = 0; w < population; ++w) {
+                const double* position = pack.position(w);
+                for (std::size_t j = 0; j < dimension; ++j) {
+                    point[j] = position[j * many_lanes + b];
+                }
+                double value;
+                if constexpr (is_span_objective<Objective>) {
+                    value = objectives[b](Span<const double>(point));
+                } else {
+                    value = objectives[b](static_cast<const std::vector<double>&>(point));
+                }
+                fitness[w * many_lanes + b] = value;
+                iteration_best = better(iteration_best, BestIndex{ value, w });
+            }
+            result.stats.evaluations += population;
+            result.stats.iterations += 1;
+
+            if (iteration_best.fitness < result.best_fitness) {
+                result.best_fitness = iteration_best.fitness;
+                const double* position = pack.position(iteration_best.index);
+                for (std::size_t j = 0; j < dimension; ++j) {
+                    result.best_position[j] = position[j * many_lanes + b];
+                }
+            }
+
+            auto diversity = [&] { return lane_diversity(pack, b, dimension, lowerbound, upperbound); };
+            if (monitor.should_stop(result.best_fitness, diversity, result.stats.stop_reason)) {
+                active[b] = false;
+                --active_lanes;
+                continue;
+            }
+
+            // Get the three best wolves (leaders) of the lane
+            std::iota(order.begin(), order.end(), 0);
+            std::partial_sort(order.begin(), order.begin() + 3, order.end(),
+                [&fitness, b](int lhs, int rhs) {
+                    double left = fitness[lhs * many_lanes + b];
+                    double right = fitness[rhs * many_lanes + b];
+                    return left < right || (left == right && lhs < rhs);
+                });
+            for (int k = 0; k < 3; ++k) {
+                const double* position = pack.position(order[k]);
+                double* leader = leaders.position(k);
+                for (std::size_t j = 0; j < dimension; ++j) {
+                    leader[j * many_lanes + b] = position[j * many_lanes + b];
+                }
+            }
+        }
+        if (active_lanes == 0) break;
+
+        // Update positions: one call moves a wolf of every lane, with the lanes in the vector lanes
+        LeaderPositions leader_positions = { leaders.position(0), leaders.position(1), leaders.position(2) };
+        double a = schedule(iter, i);
+        for (int w = 0; w < population; ++w) {
+            update_wolf(pack.position(w), leader_positions, lower, upper, width, a, group.streams[w]);
+        }
+    }
+}
+
+} // namespace gwo_detail
+
+/**
+ * @brief Solves many independent instances of one problem family in a single call.
+ *
+ * For workloads made of many small problems, where each separate run would pay its own
+ * setup, thread team and allocations. Instance `k` minimizes `objectives[k]` over the
+ * shared bounds. Instances are split into groups of `many_lanes`, and a group advances
+ * its packs together: the packs are interleaved coordinate by coordinate, so a single
+ * call of the vectorized `update_wolf` moves one wolf of every instance in the group,
+ * with the instances in the vector lanes. Groups run in parallel with OpenMP, each on
+ * one thread from start to finish, so there is no synchronization between them.
+ *
+ * Every instance has its own leaders, best position and stopping state: `criteria` is
+ * applied to each instance separately, and an instance that stops is no longer
+ * evaluated. The wall-clock budget counts from the start of the call. Results only
+ * depend on `seed` and the instance's index, not on the thread count or on the other
+ * instances. They differ from a separate `GreyWolfOptimizerT` run of the instance,
+ * whose random streams are not shared with other instances.
+ *
+ * Objectives are called on a contiguous copy of each point, with `Span<const double>` if
+ * they accept it and `const std::vector<double>&` otherwise, and must be thread-safe.
+ *
+ * @param workspace The buffers to run in; see `ManyGwoWorkspace`.
+ * @param objectives One objective per instance.
+ * @param lowerbound The lower bound of each dimension, shared by every instance.
+ * @param upperbound The upper bound of each dimension, shared by every instance.
+ * @param population The number of wolves of each instance, at least 3.
+ * @param iter The largest number of iterations of each instance.
+ * @param seed The seed of the per-group random streams.
+ * @param schedule A callable `double(int iter, int current_iter)` giving the value of `a`.
+ * @param criteria Conditions that end an instance early; see `StoppingCriteria`.
+ *
+ * @return One result per instance, valid until the workspace is reused.
+ *
+ * @throws std::invalid_argument if the population is below 3.
+ */
+template <typename Objective, typename Schedule = LinearSchedule>
+Span<const InstanceResult> GreyWolfOptimizerMany(
+    ManyGwoWorkspace& workspace,
+    const std::vector<Objective>& objectives,
+    const std::vector<double>& lowerbound,
+    const std::vector<double>& upperbound,
+    int population, int iter, std::uint64_t seed,
+    const Schedule& schedule = Schedule(),
+    const StoppingCriteria& criteria = StoppingCriteria())
+{
+    static_assert(gwo_detail::is_span_objective<Objective> || gwo_detail::is_vector_objective<Objective>,
+                  "The objective must be callable with Span<const double> or const std::vector<double>&");
+
+    using namespace gwo_detail;
+
+    if (population < 3) {
+        throw std::invalid_argument("The pack needs at least 3 wolves.");
+    }
+
+    auto run_start = Clock::now();
+    const std::size_t instances = objectives.size();
+    const int groups = static_cast<int>((instances + many_lanes - 1) / many_lanes);
+    workspace.prepare(instances, population, lowerbound.size());
+
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (int g = 0; g < groups; ++g) {
+        const std::size_t first = static_cast<std::size_t>(g) * many_lanes;
+        const std::size_t lanes = std::min(many_lanes, instances - first);
+        run_many_group(workspace.groups[thread_index()], workspace.results.data() + first, objectives.data() + first,
+                       lanes, lowerbound, upperbound, population, iter, derive_seed(seed, g, 0), schedule,
+                       criteria, run_start);
+    }
+
+    return Span<const InstanceResult>(workspace.results);
+}
+
+/**
+ * @brief Same as above, running in a temporary workspace and returning the results.
+ */
+template <typename Objective, typename Schedule = LinearSchedule>
+std::vector<InstanceResult> GreyWolfOptimizerMany(
+    const std::vector<Objective>& objectives,
+    const std::vector<double>& lowerbound,
+    const std::vector<double>& upperbound,
+    int population, int iter, std::uint64_t seed,
+    const Schedule& schedule = Schedule(),
+    const StoppingCriteria& criteria = StoppingCriteria())
+{
+    ManyGwoWorkspace workspace;
+    GreyWolfOptimizerMany(workspace, objectives, lowerbound, upperbound, population, iter, seed, schedule, criteria);
+    return std::move(workspace.results);
+}
+
+#endif // MANY_GWO_HPP
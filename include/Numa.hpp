@@ -0,0 +1,73 @@
+#ifndef NUMA_HPP
+#define NUMA_HPP
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief The NUMA nodes this process may run on, and their CPUs.
+ *
+ * Read from /sys/devices/system/node and restricted to the CPUs of the process's
+ * affinity mask. Where the kernel exposes no nodes, all allowed CPUs form node 0;
+ * on systems other than Linux, node 0 holds every hardware thread.
+ */
+struct NumaTopology {
+    std::vector<std::vector<int>> node_cpus;  ///< CPUs of each node, in increasing order.
+
+    static NumaTopology detect();
+
+    std::size_t nodes() const { return node_cpus.size(); }
+    std::size_t cpus() const;
+
+    /// The first `count` nodes only, for example to run on one socket of two.
+    NumaTopology first_nodes(std::size_t count) const;
+};
+
+/**
+ * @brief How `pin_threads` assigns OpenMP threads to CPUs.
+ */
+enum class ThreadPinning {
+    none,     ///< Threads stay where the OS puts them; every thread counts as node 0.
+    compact,  ///< Fill the CPUs of node 0, then node 1, and so on.
+    scatter   ///< Alternate between the nodes, spreading threads evenly.
+};
+
+/**
+ * @brief Where each OpenMP thread of a team runs, set by `pin_threads`.
+ *
+ * Assigning it to `BasicGwoWorkspace::placement` turns on the NUMA-aware mode of
+ * `GreyWolfOptimizerT`.
+ */
+struct ThreadPlacement {
+    std::vector<int> cpus;         ///< CPU of each thread, or -1 if it is not pinned.
+    std::vector<int> nodes;        ///< Node of each thread, from 0 to `node_count - 1`.
+    std::vector<int> node_leaders; ///< The lowest thread on each node, which keeps its copies up to date.
+    int node_count = 1;
+
+    int threads() const { return static_cast<int>(nodes.size()); }
+};
+
+/**
+ * @brief Pins the threads of the calling thread's OpenMP teams to CPUs.
+ *
+ * Sets the team size to `threads` (all CPUs of `topology` if 0) with `omp_set_num_threads`
+ * and pins each thread of a team of that size. The OpenMP runtime keeps its threads
+ * between parallel regions, so the pinning holds for later teams of the same size
+ * started from the same thread. `OMP_PROC_BIND` and `OMP_PLACES` do the same from the
+ * environment; this sets it per run, for example to compare one node with two.
+ * On systems other than Linux only the team size is set: no thread is pinned and every
+ * entry of `cpus` is -1.
+ *
+ * @throws std::invalid_argument if `topology` has no CPUs.
+ * @throws std::system_error if the kernel refuses an affinity mask.
+ */
+ThreadPlacement pin_threads(const NumaTopology& topology, ThreadPinning pinning, int threads = 0);
+
+/**
+ * @brief Lets the threads of a team of the current size run on every CPU of the process again.
+ *
+ * Does nothing on systems other than Linux.
+ */
+void unpin_threads();
+
+#endif // NUMA_HPP
@@ -0,0 +1,172 @@
+#ifndef PACK_HPP
+#define PACK_HPP
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <limits>
+#include <algorithm>
+
+/**
+ * @brief Minimal allocator returning storage aligned to `Alignment` bytes.
+ *
+ * Used so every row of the pack starts on a cache-line boundary, which keeps the
+ * position update a dense streaming loop that the compiler (and later the SIMD
+ * kernels) can load with aligned accesses.
+ */
+template <typename T, std::size_t Alignment = 64>
+struct AlignedAllocator {
+    using value_type = T;
+
+    template <typename U>
+    struct rebind { using other = AlignedAllocator<U, Alignment>; };
+
+    AlignedAllocator() noexcept = default;
+
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {}
+
+    T* allocate(std::size_t n) {
+        if (n > std::numeric_limits<std::size_t>::max() / sizeof(T)) {
+            throw std::bad_alloc();
+        }
+        std::size_t bytes = (n * sizeof(T) + Alignment - 1) / Alignment * Alignment;
+        void* memory = std::aligned_alloc(Alignment, bytes);
+        if (memory == nullptr) {
+            throw std::bad_alloc();
+        }
+        return static_cast<T*>(memory);
+    }
+
+    void deallocate(T* pointer, std::size_t) noexcept {
+        std::free(pointer);
+    }
+
+    template <typename U>
+    bool operator==(const AlignedAllocator<U, Alignment>&) const noexcept { return true; }
+
+    template <typename U>
+    bool operator!=(const AlignedAllocator<U, Alignment>&) const noexcept { return false; }
+};
+
+template <typename T>
+using AlignedVector = std::vector<T, AlignedAllocator<T>>;
+
+/**
+ * @brief `AlignedAllocator` that leaves new elements of a vector uninitialized.
+ *
+ * Growing a vector with it writes nothing, so the pages are placed on the NUMA node
+ * of the thread that first writes them rather than on the node of the one that grew
+ * the vector.
+ */
+template <typename T, std::size_t Alignment = 64>
+struct FirstTouchAllocator : AlignedAllocator<T, Alignment> {
+    template <typename U>
+    struct rebind { using other = FirstTouchAllocator<U, Alignment>; };
+
+    FirstTouchAllocator() noexcept = default;
+
+    template <typename U>
+    FirstTouchAllocator(const FirstTouchAllocator<U, Alignment>&) noexcept {}
+
+    template <typename U>
+    void construct(U* pointer) noexcept(std::is_nothrow_default_constructible_v<U>) {
+        ::new (static_cast<void*>(pointer)) U;
+    }
+
+    template <typename U, typename... Args>
+    void construct(U* pointer, Args&&... args) {
+        ::new (static_cast<void*>(pointer)) U(std::forward<Args>(args)...);
+    }
+};
+
+/**
+ * @brief Structure-of-arrays storage for a pack of wolves.
+ *
+ * All positions live in a single contiguous, 64-byte aligned buffer of
+ * `population x stride` values of type `Scalar`, where `stride` is the dimension
+ * rounded up to a whole number of cache lines. Fitness values are kept in a parallel
+ * array of doubles, so selecting leaders never touches the position data.
+ *
+ * @tparam Scalar The type of the coordinates: `double`, or `float` to halve the memory
+ *                traffic of large packs (see `FloatPack`).
+ */
+template <typename Scalar>
+class BasicPack {
+public:
+    using scalar_type = Scalar;
+
+    /// Number of coordinates per cache line; rows are padded to a multiple of this.
+    static constexpr std::size_t row_alignment = 64 / sizeof(Scalar);
+
+    BasicPack() = default;
+
+    BasicPack(std::size_t population, std::size_t dimension) {
+        resize(population, dimension);
+    }
+
+    /**
+     * @brief Resizes the pack, reusing the existing buffers when they are large enough.
+     *
+     * Padding lanes are zero-filled and fitness values reset to the largest double.
+     * With `first_touch`, the rows are zeroed by an OpenMP loop with the static schedule
+     * of the optimizer's wolf loops, so when the buffer grows, each row is placed on the
+     * NUMA node of the thread that will evaluate and update it.
+     */
+    void resize(std::size_t population, std::size_t dimension, bool first_touch = false) {
+        population_ = population;
+        dimension_ = dimension;
+        stride_ = (dimension + row_alignment - 1) / row_alignment * row_alignment;
+        positions_.clear();
+        positions_.resize(population_ * stride_);
+        if (first_touch) {
+            #pragma omp parallel for schedule(static)
+            for (std::ptrdiff_t w = 0; w < static_cast<std::ptrdiff_t>(population_); ++w) {
+                std::fill(position(w), position(w) + stride_, Scalar(0));
+            }
+        } else {
+            std::fill(positions_.begin(), positions_.end(), Scalar(0));
+        }
+        fitness_.assign(population_, std::numeric_limits<double>::max());
+    }
+
+    std::size_t population() const { return population_; }
+    std::size_t dimension() const { return dimension_; }
+    std::size_t stride() const { return stride_; }
+
+    Scalar* position(std::size_t wolf) { return positions_.data() + wolf * stride_; }
+    const Scalar* position(std::size_t wolf) const { return positions_.data() + wolf * stride_; }
+
+    double& fitness(std::size_t wolf) { return fitness_[wolf]; }
+    double fitness(std::size_t wolf) const { return fitness_[wolf]; }
+
+    Scalar* positions() { return positions_.data(); }
+    const Scalar* positions() const { return positions_.data(); }
+
+    double* fitnesses() { return fitness_.data(); }
+    const double* fitnesses() const { return fitness_.data(); }
+
+    /// Copies the row of `wolf` into the row `target` of another (or the same) pack.
+    void copy_to(std::size_t wolf, BasicPack& other, std::size_t target) const {
+        std::copy(position(wolf), position(wolf) + dimension_, other.position(target));
+        other.fitness(target) = fitness(wolf);
+    }
+
+private:
+    std::size_t population_ = 0;
+    std::size_t dimension_ = 0;
+    std::size_t stride_ = 0;
+    std::vector<Scalar, FirstTouchAllocator<Scalar>> positions_;
+    AlignedVector<double> fitness_;
+};
+
+/// The double-precision pack used by every optimizer.
+using Pack = BasicPack<double>;
+
+/// Single-precision pack, for `FloatGwoWorkspace`.
+using FloatPack = BasicPack<float>;
+
+#endif // PACK_HPP
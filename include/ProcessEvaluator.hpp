@@ -0,0 +1,101 @@
+#ifndef PROCESS_EVALUATOR_HPP
+#define PROCESS_EVALUATOR_HPP
+
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <vector>
+
+#include "BatchObjective.hpp"
+#include "Span.hpp"
+
+// Workers are forked and woken with futexes, so the evaluator exists on Linux only
+#ifdef __linux__
+#include <sys/types.h>
+
+/**
+ * @brief Counters of a `ProcessEvaluator`.
+ */
+struct ProcessEvaluatorStats {
+    long long evaluations = 0;  ///< Points evaluated, including the failed ones.
+    long long failures = 0;     ///< Points whose evaluation threw or crashed its worker.
+    long long restarts = 0;     ///< Workers forked again after one died.
+};
+
+/**
+ * @brief Batch objective that evaluates the pack in a pool of forked worker processes.
+ *
+ * For objectives that are not thread-safe, such as wrappers around legacy code with
+ * global state. The constructor forks `workers` processes, each holding its own copy
+ * of `function`'s state, and shares one anonymous memory segment with them. Every
+ * call copies the positions into the segment, wakes the workers with a futex, and
+ * waits on a second futex until the fitness of every point has been written back to
+ * the segment. Workers take points one at a time from a shared atomic counter, so
+ * slow points do not hold up the others. No data goes through pipes or sockets.
+ *
+ * A point whose evaluation throws, or whose worker crashes, gets `failure_fitness`.
+ * A crashed worker is detected while waiting, and a replacement is forked, so a
+ * crash costs one point rather than the run.
+ *
+ * Pass the evaluator itself to `GreyWolfOptimizerT`, or `std::cref(evaluator)` to
+ * `GreyWolfOptimizerBatch`. Calls must come from one thread at a time.
+ *
+ * Workers are forked from the calling process, so construct the evaluator before
+ * starting threads that hold locks `function` needs; replacements are forked from the
+ * process as it is when the crash is detected. Workers are killed if the parent dies.
+ * Linux only.
+ */
+class ProcessEvaluator {
+public:
+    /**
+     * @param function The objective, evaluated in the worker processes only.
+     * @param dimension The number of coordinates of every point.
+     * @param max_population The largest number of points a call may evaluate.
+     * @param workers The number of worker processes; 0 uses one per hardware thread.
+     * @param failure_fitness The fitness given to points whose evaluation failed.
+     *
+     * @throws std::system_error if the segment cannot be mapped or a worker cannot be forked.
+     */
+    ProcessEvaluator(std::function<double(const std::vector<double>&)> function,
+                     std::size_t dimension, std::size_t max_population, std::size_t workers = 0,
+                     double failure_fitness = std::numeric_limits<double>::max());
+
+    /// Stops and reaps every worker and unmaps the segment.
+    ~ProcessEvaluator();
+
+    ProcessEvaluator(const ProcessEvaluator&) = delete;
+    ProcessEvaluator& operator=(const ProcessEvaluator&) = delete;
+
+    /**
+     * @brief Writes the fitness of every row of `positions` to `fitness`.
+     *
+     * @throws std::invalid_argument if the dimension or population exceeds the evaluator's.
+     * @throws std::system_error if a replacement worker cannot be forked.
+     */
+    void operator()(const PopulationView& positions, Span<double> fitness) const;
+
+    ProcessEvaluatorStats stats() const { return stats_; }
+
+    std::size_t size() const { return pids_.size(); }
+
+private:
+    struct Segment;
+
+    void spawn(std::size_t worker) const;
+    void stop();
+    void reap_crashed() const;
+
+    std::function<double(const std::vector<double>&)> function_;
+    std::size_t dimension_;
+    std::size_t max_population_;
+    double failure_fitness_;
+
+    Segment* segment_ = nullptr;
+    std::size_t segment_bytes_ = 0;
+    mutable std::vector<pid_t> pids_;
+    mutable ProcessEvaluatorStats stats_;
+};
+
+#endif // __linux__
+
+#endif // PROCESS_EVALUATOR_HPP
@@ -0,0 +1,296 @@
+#ifndef PROFILER_HPP
+#define PROFILER_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+/**
+ * @brief The parts of a run of `GreyWolfOptimizerT` that the profiler times.
+ *
+ * The `_thread` phases are the busy time of each thread of a parallel phase; the
+ * others are wall time on the thread running the optimizer.
+ */
+enum class ProfilePhase : std::uint8_t {
+    none,               ///< Outside any phase.
+    initialization,     ///< Workspace sizing, bounds and the random initial pack.
+    evaluation,
+    evaluation_thread,
+    best_update,        ///< Keeping the best position found so far.
+    stopping,           ///< The stopping criteria.
+    leader_selection,   ///< The partial sort picking alpha, beta and delta.
+    leader_copy,
+    update,
+    update_thread,
+    observer,           ///< Computing and delivering telemetry samples.
+    checkpoint,
+    count
+};
+
+/**
+ * @brief Events counted by the profiler.
+ */
+enum class ProfileCounter : std::uint8_t {
+    evaluations,
+    iterations,
+    improvements,       ///< Iterations that improved the best fitness.
+    count
+};
+
+const char* to_string(ProfilePhase phase);
+const char* to_string(ProfileCounter counter);
+
+/// The profiler's clock: the time stamp counter on x86, nanoseconds elsewhere.
+inline std::uint64_t profile_ticks() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+}
+
+/**
+ * @brief One timed phase on one thread.
+ */
+struct ProfileEvent {
+    std::uint64_t start = 0;          ///< In ticks.
+    std::uint64_t duration = 0;       ///< In ticks.
+    std::uint64_t cycles = 0;         ///< Hardware counters, when enabled.
+    std::uint64_t instructions = 0;
+    std::uint64_t parent_start = 0;   ///< For `_thread` phases, the start of the phase of the team's master.
+    std::int32_t parent_thread = -1;  ///< For `_thread` phases, the master's thread id.
+    ProfilePhase phase = ProfilePhase::none;
+};
+
+/**
+ * @brief Totals of one phase.
+ */
+struct ProfilePhaseTotals {
+    long long calls = 0;
+    std::uint64_t ticks = 0;
+    std::uint64_t cycles = 0;
+    std::uint64_t instructions = 0;
+};
+
+/**
+ * @brief What one thread has recorded. Only written by its own thread.
+ */
+struct ProfileThread {
+    int id = 0;
+    std::vector<ProfileEvent> events;  ///< Capacity reserved once; later events are only totalled.
+    long long dropped = 0;             ///< Events that did not fit in `events`.
+    std::array<ProfilePhaseTotals, static_cast<std::size_t>(ProfilePhase::count)> totals{};
+    std::array<long long, static_cast<std::size_t>(ProfileCounter::count)> counters{};
+
+    // The phase the thread is in, entered by `profile_phase`
+    ProfilePhase current = ProfilePhase::none;
+    std::uint64_t current_start = 0;
+    std::uint64_t current_cycles = 0;
+    std::uint64_t current_instructions = 0;
+
+    int perf_fd = -1;                  ///< Group of the cycle and instruction counters.
+    bool perf_opened = false;          ///< Whether opening the counters was attempted.
+
+    /// Reads the hardware counters, or zeros if this thread has none.
+    void read_hardware(std::uint64_t& cycles, std::uint64_t& instructions);
+
+    void record(ProfilePhase phase, std::uint64_t start, std::uint64_t end,
+                std::uint64_t cycles, std::uint64_t instructions,
+                std::int32_t parent_thread = -1, std::uint64_t parent_start = 0) {
+        ProfilePhaseTotals& total = totals[static_cast<std::size_t>(phase)];
+        total.calls += 1;
+        total.ticks += end - start;
+        total.cycles += cycles;
+        total.instructions += instructions;
+        if (events.size() < events.capacity()) {
+            events.push_back({ start, end - start, cycles, instructions, parent_start, parent_thread, phase });
+        } else {
+            dropped += 1;
+        }
+    }
+};
+
+/**
+ * @brief Process-wide recorder of phase timings, counters and optional hardware counters.
+ *
+ * Compiled into the optimizer when `GWO_PROFILE` is defined (the CMake option of the same
+ * name); otherwise the `GWO_PROFILE_*` macros expand to nothing and cost nothing. The
+ * optimizer marks the start of each phase, so a phase boundary costs one read of the
+ * time stamp counter and one event stored in a buffer reserved per thread. Every thread
+ * keeps its own buffer and totals, so recording takes no lock after a thread's first
+ * event. The trace keeps the first `events_per_thread` events of each thread; the
+ * totals and counters cover everything.
+ *
+ * `enable_hardware_counters` adds cycle and instruction counts from Linux `perf_event`
+ * to every event. Reading them is a system call per phase boundary, so it is meant for
+ * focused runs rather than always-on profiling.
+ *
+ * The exports, `reset` and `set_enabled` must not run at the same time as a profiled run.
+ */
+class Profiler {
+public:
+    static constexpr std::size_t events_per_thread = std::size_t(1) << 16;
+
+    static Profiler& instance();
+
+    bool enabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+    /// Pauses or resumes recording; the profiler starts enabled.
+    void set_enabled(bool enabled) { enabled_.store(enabled, std::memory_order_relaxed); }
+
+    /**
+     * @brief Requests cycle and instruction counts for the events recorded from now on.
+     *
+     * @return False if `perf_event_open` is not available to this process, for example
+     *         because of `/proc/sys/kernel/perf_event_paranoid`.
+     */
+    bool enable_hardware_counters();
+
+    bool hardware_counters() const { return hardware_.load(std::memory_order_relaxed); }
+
+    /// Forgets every event, total and counter.
+    void reset();
+
+    /// The calling thread's record, created on its first use.
+    ProfileThread& thread() {
+        thread_local ProfileThread* record = nullptr;
+        if (record == nullptr) {
+            record = register_thread();
+        }
+        return *record;
+    }
+
+    ProfilePhaseTotals totals(ProfilePhase phase) const;
+    long long counter(ProfileCounter counter) const;
+    long long dropped_events() const;
+
+    /// Nanoseconds per tick, measured against `std::chrono::steady_clock` since the profiler started.
+    double nanoseconds_per_tick() const;
+
+    /// Writes the events in the Chrome trace format, for chrome://tracing or Perfetto.
+    void write_chrome_trace(std::ostream& out) const;
+
+    /// Writes a table of the phases and counters, and the busy and idle time of each thread.
+    void write_summary(std::ostream& out) const;
+
+private:
+    Profiler();
+
+    ProfileThread* register_thread();
+
+    std::atomic<bool> enabled_{true};
+    std::atomic<bool> hardware_{false};
+    mutable std::mutex mutex_;
+    std::vector<std::unique_ptr<ProfileThread>> threads_;
+    std::uint64_t epoch_ticks_;
+    std::chrono::steady_clock::time_point epoch_time_;
+};
+
+/// Ends the calling thread's current phase and starts `phase`; `ProfilePhase::none` only ends it.
+inline void profile_phase(ProfilePhase phase) {
+    Profiler& profiler = Profiler::instance();
+    if (!profiler.enabled()) return;
+
+    ProfileThread& thread = profiler.thread();
+    std::uint64_t now = profile_ticks();
+    std::uint64_t cycles = 0, instructions = 0;
+    if (thread.perf_fd >= 0 || (profiler.hardware_counters() && !thread.perf_opened)) {
+        const bool opened = thread.perf_opened;
+        thread.read_hardware(cycles, instructions);
+        if (!opened) {
+            // The counters start now, so the phase being closed gets none
+            thread.current_cycles = cycles;
+            thread.current_instructions = instructions;
+        }
+    }
+    if (thread.current != ProfilePhase::none) {
+        thread.record(thread.current, thread.current_start, now,
+                      cycles - thread.current_cycles, instructions - thread.current_instructions);
+    }
+    thread.current = phase;
+    thread.current_start = now;
+    thread.current_cycles = cycles;
+    thread.current_instructions = instructions;
+}
+
+inline void profile_count(ProfileCounter counter, long long amount) {
+    Profiler& profiler = Profiler::instance();
+    if (!profiler.enabled()) return;
+    profiler.thread().counters[static_cast<std::size_t>(counter)] += amount;
+}
+
+/**
+ * @brief The master's phase of a parallel region, captured before the region starts.
+ */
+struct ProfileTeam {
+    std::int32_t thread = -1;  ///< -1 if the profiler is disabled.
+    std::uint64_t start = 0;
+};
+
+inline ProfileTeam profile_team() {
+    Profiler& profiler = Profiler::instance();
+    if (!profiler.enabled()) return {};
+    ProfileThread& thread = profiler.thread();
+    return { thread.id, thread.current_start };
+}
+
+/**
+ * @brief Times the busy part of one thread's share of a parallel phase.
+ */
+class ProfileTeamScope {
+public:
+    ProfileTeamScope(ProfilePhase phase, const ProfileTeam& team) : phase_(phase), team_(team) {
+        if (team_.thread < 0) return;
+        Profiler& profiler = Profiler::instance();
+        thread_ = &profiler.thread();
+        hardware_ = thread_->perf_fd >= 0 || (profiler.hardware_counters() && !thread_->perf_opened);
+        if (hardware_) thread_->read_hardware(cycles_, instructions_);
+        start_ = profile_ticks();
+    }
+
+    ~ProfileTeamScope() {
+        if (thread_ == nullptr) return;
+        std::uint64_t end = profile_ticks();
+        std::uint64_t cycles = 0, instructions = 0;
+        if (hardware_) thread_->read_hardware(cycles, instructions);
+        thread_->record(phase_, start_, end, cycles - cycles_, instructions - instructions_,
+                        team_.thread, team_.start);
+    }
+
+    ProfileTeamScope(const ProfileTeamScope&) = delete;
+    ProfileTeamScope& operator=(const ProfileTeamScope&) = delete;
+
+private:
+    ProfilePhase phase_;
+    ProfileTeam team_;
+    ProfileThread* thread_ = nullptr;
+    bool hardware_ = false;
+    std::uint64_t start_ = 0;
+    std::uint64_t cycles_ = 0;
+    std::uint64_t instructions_ = 0;
+};
+
+// Instrumentation points of the optimizer, compiled out unless GWO_PROFILE is defined
+#ifdef GWO_PROFILE
+#define GWO_PROFILE_PHASE(phase) profile_phase(phase)
+#define GWO_PROFILE_COUNT(counter, amount) profile_count(counter, amount)
+#define GWO_PROFILE_TEAM(team) const ProfileTeam team = profile_team()
+#define GWO_PROFILE_TEAM_SCOPE(phase, team) ProfileTeamScope gwo_profile_team_scope(phase, team)
+#else
+#define GWO_PROFILE_PHASE(phase) static_cast<void>(0)
+#define GWO_PROFILE_COUNT(counter, amount) static_cast<void>(0)
+#define GWO_PROFILE_TEAM(team) static_cast<void>(0)
+#define GWO_PROFILE_TEAM_SCOPE(phase, team) static_cast<void>(0)
+#endif
+
+#endif // PROFILER_HPP
@@ -0,0 +1,119 @@
+#ifndef RANDOM_HPP
+#define RANDOM_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+#include "Simd.hpp"
+
+/**
+ * @brief SplitMix64 step, used to expand a single 64-bit seed into generator state.
+ */
+inline std::uint64_t splitmix64(std::uint64_t& state) {
+    std::uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/**
+ * @brief Vectorized uniform generator made of `lanes` interleaved xoshiro256+ streams.
+ *
+ * The state is stored word-major (`state[word][lane]`), so one step of all lanes is
+ * a handful of 64-bit integer vector operations. `fill_uniform` produces doubles in
+ * [0, 1) lane by lane and is dispatched at runtime to AVX-512, AVX2 or a scalar
+ * loop. All three paths produce exactly the same sequence, so the chosen
+ * instruction set never changes the results of a run.
+ *
+ * Independent streams are obtained with `jump()`, which advances every lane by 2^128
+ * steps; see `make_streams`.
+ */
+class alignas(64) VectorRng {
+public:
+    static constexpr std::size_t lanes = 8;
+
+    VectorRng() : VectorRng(0) {}
+
+    explicit VectorRng(std::uint64_t seed) {
+        this->seed(seed);
+    }
+
+    void seed(std::uint64_t seed) {
+        for (std::size_t word = 0; word < 4; ++word) {
+            for (std::size_t lane = 0; lane < lanes; ++lane) {
+                state[word][lane] = splitmix64(seed);
+            }
+        }
+    }
+
+    /**
+     * @brief Fills `out[0..n)` with uniform doubles in [0, 1).
+     *
+     * Values are produced `lanes` at a time; when `n` is not a multiple of `lanes`
+     * the unused values of the last step are discarded.
+     */
+    void fill_uniform(double* out, std::size_t n);
+
+    /// Same as above but forcing a specific instruction set (must be supported).
+    void fill_uniform(double* out, std::size_t n, SimdIsa isa);
+
+    /**
+     * @brief Fills `out[0..n)` with uniform floats in [0, 1).
+     *
+     * Every step yields two floats per lane, from two disjoint 23-bit fields of the
+     * lane's output, so floats cost half the generator steps of doubles. Values are
+     * produced `2 * lanes` at a time; the unused values of the last step are discarded.
+     */
+    void fill_uniform(float* out, std::size_t n);
+
+    /// Same as above but forcing a specific instruction set (must be supported).
+    void fill_uniform(float* out, std::size_t n, SimdIsa isa);
+
+    /**
+     * @brief Advances every lane by 2^128 steps.
+     *
+     * Equivalent to 2^128 calls to the step function, so generators obtained by
+     * repeated jumps never overlap unless one of them draws 2^128 values.
+     */
+    void jump();
+
+    std::uint64_t state[4][lanes];
+};
+
+/**
+ * @brief Creates `count` non-overlapping generators from a single seed.
+ *
+ * Stream `k` is the generator seeded with `seed` and jumped `k` times, so the
+ * streams only depend on the seed and their index. Giving every wolf its own stream
+ * makes a run reproducible regardless of how the wolves are spread over threads.
+ */
+std::vector<VectorRng> make_streams(std::uint64_t seed, std::size_t count);
+
+/// Same as above, reusing the storage of `streams`.
+void make_streams(std::uint64_t seed, std::size_t count, std::vector<VectorRng>& streams);
+
+/**
+ * @brief Derives the seed of job `(first, second)` from a base seed.
+ *
+ * The result only depends on the three values, so independent jobs (for example a
+ * function index and a repetition) get reproducible seeds whatever order they run in.
+ */
+inline std::uint64_t derive_seed(std::uint64_t base, std::uint64_t first, std::uint64_t second) {
+    std::uint64_t state = base;
+    state = splitmix64(state) ^ first;
+    state = splitmix64(state) ^ second;
+    return splitmix64(state);
+}
+
+/**
+ * @brief Draws a 64-bit seed from a 32-bit generator such as `std::mt19937`.
+ */
+template <typename Generator>
+std::uint64_t draw_seed(Generator& gen) {
+    std::uint64_t seed = static_cast<std::uint64_t>(gen()) << 32;
+    seed |= static_cast<std::uint32_t>(gen());
+    return seed;
+}
+
+#endif // RANDOM_HPP
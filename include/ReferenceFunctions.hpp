@@ -0,0 +1,33 @@
+#ifndef REFERENCE_FUNCTIONS_HPP
+#define REFERENCE_FUNCTIONS_HPP
+
+#include <vector>
+
+// Plain implementations of the benchmark functions, written directly from their
+// definitions with libm calls and no reordering. They are slow but obviously correct,
+// and the optimized functors of functions.hpp are checked against them.
+namespace reference {
+
+double DeJong(const std::vector<double>& x);
+double AxisParallelHyperEllipsoid(const std::vector<double>& x);
+double RotatedHyperEllipsoid(const std::vector<double>& x);
+double RosenbrockValley(const std::vector<double>& x);
+double Rastring(const std::vector<double>& x);
+double Schwefel(const std::vector<double>& x);
+double Griewangk(const std::vector<double>& x);
+double SumDifferentPower(const std::vector<double>& x);
+double Ackley(const std::vector<double>& x, const std::vector<double>& a);
+double Langermann(const std::vector<double>& x, const std::vector<std::vector<double>>& a, const std::vector<double>& c);
+double Michalewicz(const std::vector<double>& x, const int& m);
+double Branin(const std::vector<double>& x, const std::vector<double>& a);
+double Easom(const std::vector<double>& x);
+double GoldsteinPrice(const std::vector<double>& v);
+double SixHumpCamelBack(const std::vector<double>& x);
+double FifthDeJong(const std::vector<double>& x);
+double DropWave(const std::vector<double>& x);
+double Shubert(const std::vector<double>& x);
+double ShekelFoxholes(const std::vector<double>& x, const std::vector<std::vector<double>>& a, const std::vector<double>& c);
+
+} // namespace reference
+
+#endif // REFERENCE_FUNCTIONS_HPP
@@ -0,0 +1,83 @@
+#ifndef RING_BUFFER_HPP
+#define RING_BUFFER_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+/**
+ * @brief Bounded lock-free queue with any number of producers and one consumer.
+ *
+ * Every slot carries a sequence number telling whether it is free for the producer
+ * of a given position or holds a value for the consumer (Vyukov's bounded queue), so
+ * producers only contend on one atomic increment and never wait for each other or for
+ * the consumer. `try_push` fails instead of blocking when the queue is full.
+ *
+ * @tparam T A trivially copyable value type.
+ */
+template <typename T>
+class MpscRing {
+public:
+    /// @param capacity The number of slots, rounded up to a power of two.
+    explicit MpscRing(std::size_t capacity) {
+        std::size_t size = 1;
+        while (size < capacity) size <<= 1;
+        mask_ = size - 1;
+        slots_.reset(new Slot[size]);
+        for (std::size_t i = 0; i < size; ++i) {
+            slots_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscRing(const MpscRing&) = delete;
+    MpscRing& operator=(const MpscRing&) = delete;
+
+    std::size_t capacity() const { return mask_ + 1; }
+
+    /// Appends `value`; returns false if the queue is full. Safe from any thread.
+    bool try_push(const T& value) {
+        std::size_t position = tail_.load(std::memory_order_relaxed);
+        for (;;) {
+            Slot& slot = slots_[position & mask_];
+            std::size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            auto difference = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position);
+            if (difference == 0) {
+                if (tail_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    slot.value = value;
+                    slot.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (difference < 0) {
+                return false;  // The consumer has not freed this slot yet
+            } else {
+                position = tail_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /// Removes the oldest value into `value`; returns false if there is none. Consumer only.
+    bool try_pop(T& value) {
+        Slot& slot = slots_[head_ & mask_];
+        if (slot.sequence.load(std::memory_order_acquire) != head_ + 1) {
+            return false;
+        }
+        value = slot.value;
+        slot.sequence.store(head_ + mask_ + 1, std::memory_order_release);
+        ++head_;
+        return true;
+    }
+
+private:
+    struct alignas(64) Slot {
+        std::atomic<std::size_t> sequence;
+        T value;
+    };
+
+    std::unique_ptr<Slot[]> slots_;
+    std::size_t mask_ = 0;
+    alignas(64) std::atomic<std::size_t> tail_{0};  ///< Next position to write, shared by the producers.
+    alignas(64) std::size_t head_ = 0;              ///< Next position to read, owned by the consumer.
+};
+
+#endif // RING_BUFFER_HPP
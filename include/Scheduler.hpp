@@ -0,0 +1,73 @@
+#ifndef SCHEDULER_HPP
+#define SCHEDULER_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Work-stealing pool for coarse, independent jobs such as whole optimizer runs.
+ *
+ * Every worker owns a deque: it takes its own jobs from the back and, when empty,
+ * steals from the front of the other workers' deques. Jobs submitted from outside
+ * the pool are spread round-robin; jobs submitted from inside a job go to the
+ * submitting worker's deque.
+ *
+ * To avoid oversubscription, each worker limits the OpenMP team of the code it runs
+ * to `inner_threads` threads (1 by default), so with one job per core the optimizer's
+ * own parallel loops run serially inside each job.
+ */
+class TaskScheduler {
+public:
+    /**
+     * @param threads The number of worker threads; 0 uses `std::thread::hardware_concurrency()`.
+     * @param inner_threads The OpenMP thread count set in every worker.
+     */
+    explicit TaskScheduler(std::size_t threads = 0, int inner_threads = 1);
+    ~TaskScheduler();
+
+    TaskScheduler(const TaskScheduler&) = delete;
+    TaskScheduler& operator=(const TaskScheduler&) = delete;
+
+    /// Queues a job. Safe to call from any thread, including from inside a job.
+    void submit(std::function<void()> job);
+
+    /**
+     * @brief Blocks until every submitted job has finished.
+     *
+     * If a job threw, the first exception is rethrown here once all jobs are done.
+     */
+    void wait();
+
+    std::size_t size() const { return workers_.size(); }
+
+private:
+    struct Worker {
+        std::mutex mutex;
+        std::deque<std::function<void()>> jobs;
+    };
+
+    void run(std::size_t index, int inner_threads);
+    bool try_pop(std::size_t index, std::function<void()>& job);
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::vector<std::thread> threads_;
+
+    std::mutex mutex_;
+    std::condition_variable work_available_;
+    std::condition_variable all_done_;
+    std::atomic<std::size_t> queued_{0};  ///< Jobs waiting in some deque.
+    std::size_t pending_ = 0;             ///< Jobs submitted and not yet finished (guarded by mutex_).
+    std::atomic<std::size_t> next_{0};    ///< Round-robin target for external submissions.
+    bool stopping_ = false;
+    std::exception_ptr error_;
+};
+
+#endif // SCHEDULER_HPP
@@ -0,0 +1,42 @@
+#ifndef SIMD_HPP
+#define SIMD_HPP
+
+/**
+ * @brief Instruction sets the vectorized kernels can be dispatched to.
+ *
+ * Every kernel has a portable scalar version; the wider versions are compiled with
+ * per-function target attributes and only selected when the CPU reports support.
+ */
+enum class SimdIsa {
+    Scalar,
+    Avx2,
+    Avx512
+};
+
+/**
+ * @brief Returns the widest instruction set supported by the running CPU.
+ */
+inline SimdIsa detect_simd_isa() {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    if (__builtin_cpu_supports("avx512f")) return SimdIsa::Avx512;
+    if (__builtin_cpu_supports("avx2")) return SimdIsa::Avx2;
+#endif
+    return SimdIsa::Scalar;
+}
+
+/**
+ * @brief Returns true if `isa` can run on this CPU.
+ */
+inline bool simd_isa_supported(SimdIsa isa) {
+    return static_cast<int>(isa) <= static_cast<int>(detect_simd_isa());
+}
+
+inline const char* simd_isa_name(SimdIsa isa) {
+    switch (isa) {
+        case SimdIsa::Avx2: return "avx2";
+        case SimdIsa::Avx512: return "avx512";
+        default: return "scalar";
+    }
+}
+
+#endif // SIMD_HPP
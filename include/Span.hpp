@@ -0,0 +1,53 @@
+#ifndef SPAN_HPP
+#define SPAN_HPP
+
+#include <array>
+#include <cstddef>
+#include <vector>
+#include <type_traits>
+
+/**
+ * @brief Non-owning view of a contiguous array, a small stand-in for C++20's `std::span`.
+ */
+template <typename T>
+class Span {
+public:
+    using element_type = T;
+    using value_type = std::remove_cv_t<T>;
+
+    Span() = default;
+
+    Span(T* data, std::size_t size) : data_(data), size_(size) {}
+
+    template <typename Allocator>
+    Span(std::vector<value_type, Allocator>& vector) : data_(vector.data()), size_(vector.size()) {}
+
+    template <typename Allocator, typename U = T, typename = std::enable_if_t<std::is_const<U>::value>>
+    Span(const std::vector<value_type, Allocator>& vector) : data_(vector.data()), size_(vector.size()) {}
+
+    template <std::size_t N>
+    Span(std::array<value_type, N>& array) : data_(array.data()), size_(N) {}
+
+    template <std::size_t N, typename U = T, typename = std::enable_if_t<std::is_const<U>::value>>
+    Span(const std::array<value_type, N>& array) : data_(array.data()), size_(N) {}
+
+    template <typename U, typename = std::enable_if_t<std::is_same<const U, T>::value>>
+    Span(const Span<U>& other) : data_(other.data()), size_(other.size()) {}
+
+    T* data() const { return data_; }
+    std::size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    T& operator[](std::size_t i) const { return data_[i]; }
+
+    T* begin() const { return data_; }
+    T* end() const { return data_ + size_; }
+
+    Span subspan(std::size_t offset, std::size_t count) const { return Span(data_ + offset, count); }
+
+private:
+    T* data_ = nullptr;
+    std::size_t size_ = 0;
+};
+
+#endif // SPAN_HPP
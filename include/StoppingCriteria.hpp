@@ -0,0 +1,62 @@
+#ifndef STOPPING_CRITERIA_HPP
+#define STOPPING_CRITERIA_HPP
+
+#include <limits>
+
+/**
+ * @brief Why a run of the optimizer stopped.
+ */
+enum class StopReason {
+    iterations,       ///< The iteration count given to the optimizer was reached.
+    target_fitness,   ///< The best fitness reached `StoppingCriteria::target_fitness`.
+    stagnation,       ///< The best fitness stopped improving for `stagnation_iterations`.
+    diversity,        ///< The pack collapsed below `min_diversity`.
+    max_evaluations,  ///< Another iteration would have exceeded the evaluation budget.
+    deadline          ///< The run used up `max_seconds`.
+};
+
+inline const char* to_string(StopReason reason) {
+    switch (reason) {
+    case StopReason::iterations: return "iterations";
+    case StopReason::target_fitness: return "target_fitness";
+    case StopReason::stagnation: return "stagnation";
+    case StopReason::diversity: return "diversity";
+    case StopReason::max_evaluations: return "max_evaluations";
+    case StopReason::deadline: return "deadline";
+    }
+    return "unknown";
+}
+
+/**
+ * @brief Conditions that end a run before its iteration count is reached.
+ *
+ * Every criterion is disabled by default, and the first one met ends the run. They are
+ * checked once per iteration, after the pack has been evaluated and before it moves, so
+ * the best position returned is the best one evaluated. The iteration count passed to
+ * the optimizer remains the upper bound, and still drives the `a` schedule.
+ */
+struct StoppingCriteria {
+    /// Stop once the best fitness is at or below this value.
+    double target_fitness = -std::numeric_limits<double>::infinity();
+
+    /// Stop after this many consecutive iterations without improvement; 0 disables it.
+    int stagnation_iterations = 0;
+
+    /// The decrease of the best fitness that counts as an improvement for `stagnation_iterations`.
+    double stagnation_tolerance = 0.0;
+
+    /// Stop once the pack diversity falls below this value. The diversity is the mean over
+    /// the coordinates of their standard deviation across the pack, divided by the width
+    /// of the bounds, so it starts near 0.29 for a uniform pack and is 0 once it collapses.
+    double min_diversity = 0.0;
+
+    /// Objective evaluation budget; 0 means unlimited. An iteration that would exceed it is
+    /// not started, except the first one, which always runs.
+    long long max_evaluations = 0;
+
+    /// Wall-clock budget of the run, in seconds, measured from its start. It is checked
+    /// between iterations, so a run can exceed it by the duration of one iteration.
+    double max_seconds = std::numeric_limits<double>::infinity();
+};
+
+#endif // STOPPING_CRITERIA_HPP
@@ -0,0 +1,122 @@
+#ifndef TELEMETRY_HPP
+#define TELEMETRY_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <thread>
+
+#include "RingBuffer.hpp"
+
+/**
+ * @brief What the optimizer reports to an observer after each iteration.
+ *
+ * Fitness, diversity and `a` describe the pack as evaluated in this iteration; the
+ * timings are those of its evaluation and of the position update that follows it,
+ * which is 0 if the run stopped before moving the pack.
+ */
+struct IterationSample {
+    std::uint64_t run = 0;            ///< Set by the observer, to tell concurrent runs apart.
+    std::int64_t iteration = 0;
+    std::int64_t evaluations = 0;     ///< Objective calls since the start of the run.
+    double best_fitness = 0.0;        ///< Best fitness found so far.
+    double mean_fitness = 0.0;        ///< Mean fitness of the pack in this iteration.
+    double diversity = 0.0;           ///< See `StoppingCriteria::min_diversity`.
+    double a = 0.0;
+    double evaluation_seconds = 0.0;
+    double update_seconds = 0.0;
+};
+
+/**
+ * @brief The default observer of `GreyWolfOptimizerT`, which disables telemetry.
+ *
+ * The optimizer skips everything related to samples at compile time when given this
+ * type, so runs without an observer pay nothing for the feature.
+ */
+struct NullObserver {
+    void operator()(const IterationSample&) const {}
+};
+
+enum class TelemetryFormat {
+    csv,     ///< A header line, then one line per sample.
+    binary   ///< A 16-byte header ("GWOTLM", version, record size), then the raw samples.
+};
+
+class TelemetryStream;
+
+/**
+ * @brief Observer posting the samples of one run to a `TelemetryStream`.
+ */
+struct TelemetryObserver {
+    TelemetryStream* stream;
+    std::uint64_t run;
+
+    inline void operator()(const IterationSample& sample) const;
+};
+
+/**
+ * @brief Writes the samples of any number of runs to a CSV or binary file.
+ *
+ * Observers post samples to a lock-free ring buffer, and a background thread drains it
+ * to the file, so the optimizer never waits on I/O or on other runs. If the writer falls
+ * so far behind that the ring is full, new samples are dropped and counted rather than
+ * slowing the optimizer down. The destructor writes every sample still queued.
+ */
+class TelemetryStream {
+public:
+    /**
+     * @param path The output file, truncated on opening.
+     * @param format The file format.
+     * @param capacity The number of samples the ring buffer holds.
+     *
+     * @throws std::runtime_error if the file cannot be opened.
+     */
+    explicit TelemetryStream(const std::string& path, TelemetryFormat format = TelemetryFormat::csv,
+                             std::size_t capacity = 1 << 14);
+    ~TelemetryStream();
+
+    TelemetryStream(const TelemetryStream&) = delete;
+    TelemetryStream& operator=(const TelemetryStream&) = delete;
+
+    /// An observer for `GreyWolfOptimizerT` tagging its samples with `run`.
+    TelemetryObserver observer(std::uint64_t run = 0) { return TelemetryObserver{ this, run }; }
+
+    /// Queues a sample; returns false, dropping it, if the ring is full. Safe from any thread.
+    bool push(const IterationSample& sample) {
+        if (!ring_.try_push(sample)) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        pushed_.fetch_add(1, std::memory_order_release);
+        return true;
+    }
+
+    /// Waits until every sample pushed so far is written to the file.
+    void flush();
+
+    long long written() const { return written_.load(std::memory_order_acquire); }
+    long long dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+    void run();
+    void write(const IterationSample& sample);
+
+    MpscRing<IterationSample> ring_;
+    std::ofstream file_;
+    TelemetryFormat format_;
+    std::atomic<long long> pushed_{0};
+    std::atomic<long long> written_{0};
+    std::atomic<long long> dropped_{0};
+    std::atomic<bool> stop_{false};
+    std::thread writer_;
+};
+
+inline void TelemetryObserver::operator()(const IterationSample& sample) const {
+    IterationSample tagged = sample;
+    tagged.run = run;
+    stream->push(tagged);
+}
+
+#endif // TELEMETRY_HPP
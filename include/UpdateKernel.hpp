@@ -0,0 +1,69 @@
+#ifndef UPDATE_KERNEL_HPP
+#define UPDATE_KERNEL_HPP
+
+#include <cstddef>
+
+#include "Random.hpp"
+#include "Simd.hpp"
+
+/// Number of dimensions whose random coefficients are drawn in one refill.
+constexpr std::size_t update_block_size = 256;
+
+/**
+ * @brief Positions of the alpha, beta and delta wolves for one iteration.
+ */
+template <typename Scalar>
+struct BasicLeaderPositions {
+    const Scalar* alpha;
+    const Scalar* beta;
+    const Scalar* delta;
+};
+
+using LeaderPositions = BasicLeaderPositions<double>;
+using FloatLeaderPositions = BasicLeaderPositions<float>;
+
+/**
+ * @brief Moves one wolf towards the three leaders, a block of dimensions at a time.
+ *
+ * For every dimension `j` the wolf is pulled towards each leader `L` with
+ * `X_L = L[j] - A * |C * L[j] - x[j]|`, where `A = 2 * a * r1 - a` and `C = 2 * r2`,
+ * and the new position is `clamp((X_alpha + X_beta + X_delta) / 3, lower[j], upper[j])`.
+ * The six coefficients per dimension are drawn from `rng` in blocks of
+ * `update_block_size` dimensions and the arithmetic is done with AVX-512, AVX2 or
+ * scalar code, chosen once at runtime.
+ *
+ * @param position The wolf's position, updated in place.
+ * @param leaders The alpha, beta and delta positions.
+ * @param lower Lower bound of each dimension.
+ * @param upper Upper bound of each dimension.
+ * @param dimension The number of dimensions.
+ * @param a The current value of the `a` parameter.
+ * @param rng The generator supplying the random coefficients.
+ */
+void update_wolf(double* position, const LeaderPositions& leaders,
+                 const double* lower, const double* upper,
+                 std::size_t dimension, double a, VectorRng& rng);
+
+/// Same as above but forcing a specific instruction set (must be supported).
+void update_wolf(double* position, const LeaderPositions& leaders,
+                 const double* lower, const double* upper,
+                 std::size_t dimension, double a, VectorRng& rng, SimdIsa isa);
+
+/**
+ * @brief Single-precision version of `update_wolf`.
+ *
+ * The same update on float positions and bounds, with float coefficients drawn by
+ * `VectorRng::fill_uniform(float*, ...)`. A vector holds twice as many coordinates and
+ * every coordinate moves half the bytes, which is what matters for large packs whose
+ * update is bound by memory bandwidth.
+ */
+void update_wolf(float* position, const FloatLeaderPositions& leaders,
+                 const float* lower, const float* upper,
+                 std::size_t dimension, double a, VectorRng& rng);
+
+/// Same as above but forcing a specific instruction set (must be supported).
+void update_wolf(float* position, const FloatLeaderPositions& leaders,
+                 const float* lower, const float* upper,
+                 std::size_t dimension, double a, VectorRng& rng, SimdIsa isa);
+
+#endif // UPDATE_KERNEL_HPP
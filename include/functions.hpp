@@ -1,27 +1,564 @@
 #ifndef FUNCTIONS_HPP
 #define FUNCTIONS_HPP
 
+#include <array>
 #include <vector>
-#include <functional>  
+#include <functional>
+#include <cmath>
+#include <stdexcept>
+#include <algorithm>
+#include <utility>
 
+#include "CoefficientSet.hpp"
+#include "FastMath.hpp"
+#include "Span.hpp"
+
+// Benchmark functions as functor types. Parameters are captured at construction and
+// the call operators are defined inline, so `GreyWolfOptimizerT` can inline them.
+// They accept any contiguous range through `Span<const double>`, including vectors.
+//
+// The loops over the dimensions are marked `#pragma omp simd` and call the branch-free
+// functions of FastMath.hpp instead of libm, so they compile to vector code. The
+// reductions may be reordered, so results can differ from the plain loops in
+// ReferenceFunctions.hpp by a few ulp; the benchmark harness checks the difference.
+
+/**
+ * @brief Base of the objectives defined for any number of dimensions.
+ *
+ * `Derived` implements `template <typename T> double evaluate(Span<const T>) const`,
+ * and this base turns it into call operators for double and float positions, so the
+ * objective can be used by both `GwoWorkspace` and `FloatGwoWorkspace` runs. Float
+ * coordinates are widened to double as they are loaded, so the sums are accumulated
+ * in double either way.
+ */
+template <typename Derived>
+struct ScalarObjective {
+    double operator()(Span<const double> x) const { return static_cast<const Derived&>(*this).evaluate(x); }
+    double operator()(Span<const float> x) const { return static_cast<const Derived&>(*this).evaluate(x); }
+};
+
+// Separable objectives are a sum of one term per coordinate. They also implement
+// `template <typename T> double partial(Span<const T> block, std::size_t offset) const`,
+// the sum of the terms of coordinates offset to offset + block.size() - 1, so the sum of
+// the partials of the blocks of x is the value at x. `GreyWolfOptimizerCooperative`
+// uses it to evaluate a change of one block in time proportional to the block.
+
+/**
+ * @brief Base of the objectives defined for `Dimension` variables only.
+ *
+ * `Derived` implements `double evaluate(const double* x) const` on exactly `Dimension`
+ * coordinates and names its error message `dimension_error`. Called with a span, the
+ * size is checked and `std::invalid_argument` thrown on a mismatch; called with a
+ * `std::array` of the right size, as `GreyWolfOptimizerFixed` does, there is nothing
+ * left to check at runtime. `fixed_dimension` lets the optimizer check it at compile time.
+ */
+template <typename Derived, std::size_t Dimension>
+struct FixedObjective {
+    static constexpr std::size_t fixed_dimension = Dimension;
+
+    double operator()(Span<const double> x) const {
+        if (x.size() != Dimension) {
+            throw std::invalid_argument(Derived::dimension_error);
+        }
+        return static_cast<const Derived&>(*this).evaluate(x.data());
+    }
+
+    double operator()(const std::array<double, Dimension>& x) const {
+        return static_cast<const Derived&>(*this).evaluate(x.data());
+    }
+};
+
+// Función de DeJong
+struct DeJongObjective : ScalarObjective<DeJongObjective> {
+    template <typename T>
+    double evaluate(Span<const T> x) const { return partial(x, 0); }
+
+    template <typename T>
+    double partial(Span<const T> x, std::size_t) const {
+        const T* values = x.data();
+        double sum = 0.0;
+
+        #pragma omp simd reduction(+ : sum)
+        for (std::size_t i = 0; i < x.size(); ++i) {
+            const double xi = values[i];
+            sum += xi * xi;
+        }
+        return sum;
+    }
+};
+
+// Función Hiperellipsoide Paralelo a los Ejes
+struct AxisParallelHyperEllipsoidObjective : ScalarObjective<AxisParallelHyperEllipsoidObjective> {
+    template <typename T>
+    double evaluate(Span<const T> x) const { return partial(x, 0); }
+
+    template <typename T>
+    double partial(Span<const T> x, std::size_t offset) const {
+        const T* values = x.data();
+        const int n = static_cast<int>(x.size());
+        const int first = static_cast<int>(offset);
+        double sum = 0.0;
+
+        // An int index converts to double in a single vector instruction on every x86 level
+        #pragma omp simd reduction(+ : sum)
+        for (int i = 0; i < n; ++i) {
+            const double xi = values[i];
+            sum += (first + i) * xi * xi;
+        }
+        return sum;
+    }
+};
+
+// Función de Hyperellipsoide Rotado
+struct RotatedHyperEllipsoidObjective : ScalarObjective<RotatedHyperEllipsoidObjective> {
+    template <typename T>
+    double evaluate(Span<const T> x) const {
+        // The sum of the prefix sums of x_i^2 counts each x_i^2 once per prefix
+        // containing it, that is (n - i) times, which removes the loop-carried prefix sum
+        const T* values = x.data();
+        const int n = static_cast<int>(x.size());
+        double sum = 0.0;
+
+        #pragma omp simd reduction(+ : sum)
+        for (int i = 0; i < n; ++i) {
+            const double xi = values[i];
+            sum += (n - i) * xi * xi;
+        }
+        return sum;
+    }
+};
+
+// Función Rosenbrok (Valle de Rosenbrock)
+struct RosenbrockValleyObjective : ScalarObjective<RosenbrockValleyObjective> {
+    template <typename T>
+    double evaluate(Span<const T> x) const {
+        const T* values = x.data();
+        const std::size_t pairs = x.empty() ? 0 : x.size() - 1;
+        double sum = 0.0;
+
+        #pragma omp simd reduction(+ : sum)
+        for (std::size_t i = 0; i < pairs; ++i) {
+            const double xi = values[i];
+            const double next = values[i + 1];
+            double valley = next - xi * xi;
+            double slope = 1 - xi;
+            sum += 100 * valley * valley + slope * slope;
+        }
+        return sum;
+    }
+};
+
+// Función de Rastring
+struct RastringObjective : ScalarObjective<RastringObjective> {
+    template <typename T>
+    double evaluate(Span<const T> x) const { return partial(x, 0); }
+
+    template <typename T>
+    double partial(Span<const T> x, std::size_t) const {
+        const T* values = x.data();
+        double sum = 10.0 * x.size();
+
+        #pragma omp simd reduction(+ : sum)
+        for (std::size_t i = 0; i < x.size(); ++i) {
+            const double xi = values[i];
+            sum += xi * xi - 10 * fast_cos(2 * M_PI * xi);
+        }
+        return sum;
+    }
+};
+
+// Función de Schwefel
+struct SchwefelObjective : ScalarObjective<SchwefelObjective> {
+    template <typename T>
+    double evaluate(Span<const T> x) const { return partial(x, 0); }
+
+    template <typename T>
+    double partial(Span<const T> x, std::size_t) const {
+        const T* values = x.data();
+        double sum = 0.0;
+
+        #pragma omp simd reduction(+ : sum)
+        for (std::size_t i = 0; i < x.size(); ++i) {
+            const double xi = values[i];
+            sum -= xi * fast_sin(std::sqrt(std::abs(xi)));
+        }
+        return sum;
+    }
+};
+
+// Función de Griewangk
+struct GriewangkObjective : ScalarObjective<GriewangkObjective> {
+    std::vector<double> inverse_sqrt;  ///< 1 / sqrt(i + 1) for the first dimensions
+
+    /// Precomputes the scale factors of `dimension` dimensions; larger inputs compute the rest on the fly.
+    explicit GriewangkObjective(std::size_t dimension = 0) : inverse_sqrt(dimension) {
+        for (std::size_t i = 0; i < dimension; ++i) {
+            inverse_sqrt[i] = 1.0 / std::sqrt(i + 1.0);
+        }
+    }
+
+    template <typename T>
+    double evaluate(Span<const T> x) const {
+        const T* values = x.data();
+        const double* scales = inverse_sqrt.data();
+        const std::size_t tabulated = std::min(x.size(), inverse_sqrt.size());
+        double sum = 0.0;
+        double product = 1.0;
+
+        #pragma omp simd reduction(+ : sum) reduction(* : product)
+        for (std::size_t i = 0; i < tabulated; ++i) {
+            const double xi = values[i];
+            sum += xi * xi;
+            product *= fast_cos(xi * scales[i]);
+        }
+        #pragma omp simd reduction(+ : sum) reduction(* : product)
+        for (std::size_t i = tabulated; i < x.size(); ++i) {
+            const double xi = values[i];
+            sum += xi * xi;
+            product *= fast_cos(xi / std::sqrt(i + 1.0));
+        }
+        sum /= 4000;
+        return sum - product + 1;
+    }
+};
+
+// Función Suma de Diferentes Potencias
+struct SumDifferentPowerObjective : ScalarObjective<SumDifferentPowerObjective> {
+    template <typename T>
+    double evaluate(Span<const T> x) const {
+        // The exponent changes with i, so this loop stays scalar; ipow still
+        // replaces the generic pow with a few multiplications
+        double sum = 0.0;
+        for (std::size_t i = 0; i < x.size(); ++i) {
+            sum += ipow(std::abs(static_cast<double>(x[i])), static_cast<unsigned>(i + 2));
+        }
+        return sum;
+    }
+};
+
+// Función Ackley, con parámetros a = {a, b, c}
+struct AckleyObjective : ScalarObjective<AckleyObjective> {
+    double a, b, c;
+
+    explicit AckleyObjective(const std::vector<double>& parameters) {
+        if (parameters.size() != 3) {
+            throw std::invalid_argument("Ackley function requires 3 parameters.");
+        }
+        a = parameters[0];
+        b = parameters[1];
+        c = parameters[2];
+    }
+
+    template <typename T>
+    double evaluate(Span<const T> x) const {
+        const std::size_t n = x.size();
+        if (n == 0) return 0.0;
+        const T* values = x.data();
+        double mean_1 = 0.0, mean_2 = 0.0;
+
+        #pragma omp simd reduction(+ : mean_1, mean_2)
+        for (std::size_t i = 0; i < n; ++i) {
+            const double xi = values[i];
+            mean_1 += xi * xi;
+            mean_2 += fast_cos(c * xi);
+        }
+
+        mean_1 /= n;
+        mean_2 /= n;
+
+        return -a * std::exp(-b * std::sqrt(mean_1)) - std::exp(mean_2) + a + M_E;
+    }
+};
+
+// Función de Langermann
+struct LangermannObjective {
+    CoefficientSet coefficients;  ///< Centers a_i and weights c_i, shared between copies
+
+    /// Uses the first `c.size()` rows of `a` as centers.
+    LangermannObjective(const std::vector<std::vector<double>>& a, const std::vector<double>& c)
+        : coefficients(first_rows(a, c.size()), c) {}
+
+    explicit LangermannObjective(CoefficientSet coefficients) : coefficients(std::move(coefficients)) {}
+
+    /// The number of variables, set by the coefficients.
+    std::size_t dimension() const { return coefficients.dimension(); }
+
+    double operator()(Span<const double> x) const {
+        if (x.size() != coefficients.dimension()) {
+            throw std::invalid_argument("Dimension mismatch: x must have the same size as the rows of a.");
+        }
+        return evaluate(x.data());
+    }
+
+    /// Unchecked: `GreyWolfOptimizerFixed` compares `dimension()` with `Dim` once per run.
+    template <std::size_t Dim>
+    double operator()(const std::array<double, Dim>& x) const {
+        return evaluate(x.data());
+    }
+
+    double evaluate(const double* x) const {
+        constexpr std::size_t tile = 256;
+        double dist_sq[tile];
+        const double* c = coefficients.weights();
+        double sum = 0.0;
+
+        // Whole padded rows are used, so every loop is a multiple of the vector width;
+        // padding centers have a zero weight and add nothing
+        for (std::size_t start = 0; start < coefficients.size(); start += tile) {
+            const std::size_t count = std::min(tile, coefficients.stride() - start);
+            coefficients.squared_distances(x, start, count, dist_sq);
+
+            #pragma omp simd reduction(+ : sum)
+            for (std::size_t k = 0; k < count; ++k) {
+                sum += c[start + k] * fast_exp(-dist_sq[k] / M_PI) * fast_cos(M_PI * dist_sq[k]);
+            }
+        }
+        return sum;
+    }
+
+    static std::vector<std::vector<double>> first_rows(const std::vector<std::vector<double>>& a, std::size_t count) {
+        if (a.size() < count) {
+            throw std::invalid_argument("Dimension mismatch: a must have at least as many rows as c has elements.");
+        }
+        return std::vector<std::vector<double>>(a.begin(), a.begin() + count);
+    }
+};
+
+// Función de Michalewicz
+struct MichalewiczObjective : ScalarObjective<MichalewiczObjective> {
+    int m;
+
+    explicit MichalewiczObjective(int m) : m(m) {}
+
+    template <typename T>
+    double evaluate(Span<const T> x) const {
+        // Works on blocks of dimensions so that raising to the power 2m, whose
+        // squarings are the same for every dimension, is also a vector loop
+        constexpr std::size_t block = 64;
+        double sines[block];
+        double squares[block];
+        double powers[block];
+        const T* values = x.data();
+        double sum = 0.0;
+
+        for (std::size_t start = 0; start < x.size(); start += block) {
+            const std::size_t count = std::min(block, x.size() - start);
+            const double first = start + 1.0;
+
+            #pragma omp simd
+            for (int k = 0; k < static_cast<int>(count); ++k) {
+                const double xi = values[start + k];
+                const double inner = fast_sin((first + k) * xi / M_PI);
+                sines[k] = fast_sin(xi);
+                squares[k] = inner * inner;
+                powers[k] = 1.0;
+            }
+            for (unsigned exponent = static_cast<unsigned>(m); exponent != 0; exponent >>= 1) {
+                if (exponent & 1) {
+                    #pragma omp simd
+                    for (std::size_t k = 0; k < count; ++k) powers[k] *= squares[k];
+                }
+                #pragma omp simd
+                for (std::size_t k = 0; k < count; ++k) squares[k] *= squares[k];
+            }
+            #pragma omp simd reduction(+ : sum)
+            for (std::size_t k = 0; k < count; ++k) {
+                sum -= sines[k] * powers[k];
+            }
+        }
+        return sum;
+    }
+};
+
+// Función de Branin
+struct BraninObjective : FixedObjective<BraninObjective, 2> {
+    static constexpr const char* dimension_error = "Branin function is only for two variables (x1, x2).";
+
+    std::array<double, 6> a;
+
+    explicit BraninObjective(const std::vector<double>& a) {
+        if (a.size() != 6) {
+            throw std::invalid_argument("Branin function requires only 6 arguments. ");
+        }
+        std::copy(a.begin(), a.end(), this->a.begin());
+    }
+
+    double evaluate(const double* x) const {
+        double term = x[1] - a[1] * x[0] * x[0] + a[2] * x[0] - a[3];
+        return a[0] * term * term + a[4] * (1 - a[5]) * fast_cos(x[0]) + a[5];
+    }
+};
+
+// Función de Easom
+struct EasomObjective : FixedObjective<EasomObjective, 2> {
+    static constexpr const char* dimension_error = "La función de Easom solo toma dos variables.";
+
+    double evaluate(const double* x) const {
+        double dx = x[0] - M_PI;
+        double dy = x[1] - M_PI;
+        return -fast_cos(x[0]) * fast_cos(x[1]) * fast_exp(-(dx * dx + dy * dy));
+    }
+};
+
+// Función de Goldstein-Price
+struct GoldsteinPriceObjective : FixedObjective<GoldsteinPriceObjective, 2> {
+    static constexpr const char* dimension_error = "La función sólo toma dos variables.";
+
+    double evaluate(const double* v) const {
+        double x = v[0];
+        double y = v[1];
+        double s = x + y + 1;
+        double t = 2 * x - 3 * y;
+
+        return (1 + s * s * (19 - 14 * x + 3 * x * x - 14 * y + 6 * x * y + 3 * y * y)) *
+            (30 + t * t * (18 - 32 * x + 12 * x * x + 48 * y - 36 * x * y + 27 * y * y));
+    }
+};
+
+// Función Six-Hump Camel Back
+struct SixHumpCamelBackObjective : FixedObjective<SixHumpCamelBackObjective, 2> {
+    static constexpr const char* dimension_error = "La función sólo toma dos variables.";
+
+    double evaluate(const double* x) const {
+        double x1_sq = x[0] * x[0];
+        double x2_sq = x[1] * x[1];
+
+        return (4 - 2.1 * x1_sq + x1_sq * x1_sq / 3.0) * x1_sq + x[0] * x[1] +
+            (-4 + 4 * x2_sq) * x2_sq;
+    }
+};
+
+// Quinta función de DeJong
+struct FifthDeJongObjective : FixedObjective<FifthDeJongObjective, 2> {
+    static constexpr const char* dimension_error = "La función sólo toma dos variables.";
+
+    double evaluate(const double* x) const {
+        // The sixth powers only depend on one of the two indices, so there are 10, not 50
+        double powers_1[5];
+        double powers_2[5];
+        for (int k = 0; k < 5; k++) {
+            double d1 = x[0] - 16 * (k - 2);
+            double d2 = x[1] - 16 * (k - 2);
+            powers_1[k] = ipow(d1, 6);
+            powers_2[k] = ipow(d2, 6);
+        }
+
+        double sum = 0.0;
+        for (int i = -2; i <= 2; i++) {
+            for (int j = -2; j <= 2; j++) {
+                sum += 1 / (5 + (i + 2) + j + 3 + powers_1[j + 2] + powers_2[i + 2]);
+            }
+        }
+        return 1 / (0.002 + sum);
+    }
+};
+
+// Función de Dropwave
+struct DropWaveObjective : FixedObjective<DropWaveObjective, 2> {
+    static constexpr const char* dimension_error = "La función sólo toma dos variables.";
+
+    double evaluate(const double* x) const {
+        return -(1 + fast_cos(12 * std::sqrt(x[1] + x[1] * x[1]))) /
+            (((x[0] * x[0] + x[1] * x[1]) / 2) + 2);
+    }
+};
+
+// Función de Shubert
+struct ShubertObjective : FixedObjective<ShubertObjective, 2> {
+    static constexpr const char* dimension_error = "La función sólo toma dos variables.";
+
+    double evaluate(const double* x) const {
+        double suma1 = 0;
+        double suma2 = 0;
+
+        #pragma omp simd reduction(+ : suma1, suma2)
+        for (int i = 1; i <= 5; i++) {
+            suma1 += i * fast_cos((i + 1) * x[0] + 1);
+            suma2 += i * fast_cos((i + 1) * x[1] + 1);
+        }
+        return -(suma1 * suma2);
+    }
+};
+
+// Función de hoyos de zorros de Shekel
+struct ShekelFoxholesObjective {
+    CoefficientSet coefficients;  ///< Holes a_i and depths c_i, shared between copies
+
+    /// Uses the first `a.size()` values of `c` as depths.
+    ShekelFoxholesObjective(const std::vector<std::vector<double>>& a, const std::vector<double>& c)
+        : coefficients(a, first_values(c, a.size())) {}
+
+    explicit ShekelFoxholesObjective(CoefficientSet coefficients) : coefficients(std::move(coefficients)) {}
+
+    /// The number of variables, set by the coefficients.
+    std::size_t dimension() const { return coefficients.dimension(); }
+
+    double operator()(Span<const double> x) const {
+        if (x.size() != coefficients.dimension()) {
+            throw std::invalid_argument("Dimension mismatch: x must have the same size as the rows of a.");
+        }
+        return evaluate(x.data());
+    }
+
+    /// Unchecked: `GreyWolfOptimizerFixed` compares `dimension()` with `Dim` once per run.
+    template <std::size_t Dim>
+    double operator()(const std::array<double, Dim>& x) const {
+        return evaluate(x.data());
+    }
+
+    double evaluate(const double* x) const {
+        // Tiles of holes keep the distances in L1 while the coordinates stream through
+        constexpr std::size_t tile = 256;
+        double suma2[tile];
+        const double* c = coefficients.weights();
+        double suma1 = 0.0;
+
+        for (std::size_t start = 0; start < coefficients.size(); start += tile) {
+            // As for Langermann, whole padded rows are used; padding holes are masked
+            // out arithmetically, with a denominator of at least 1 to avoid 0 / 0
+            const int count = static_cast<int>(std::min(tile, coefficients.stride() - start));
+            const int holes = static_cast<int>(std::min(tile, coefficients.size() - start));
+            coefficients.squared_distances(x, start, count, suma2);
+
+            #pragma omp simd reduction(+ : suma1)
+            for (int k = 0; k < count; ++k) {
+                double valid = k < holes;
+                suma1 -= valid / ((suma2[k] + c[start + k]) + (1.0 - valid));
+            }
+        }
+        return suma1;
+    }
+
+    static std::vector<double> first_values(const std::vector<double>& c, std::size_t count) {
+        if (c.size() < count) {
+            throw std::invalid_argument("Dimension mismatch: c must have at least as many elements as a has rows.");
+        }
+        return std::vector<double>(c.begin(), c.begin() + count);
+    }
+};
+
+// Per-point functions, kept for the `std::function` based interface
 double DeJong(const std::vector<double>& x);
 double AxisParallelHyperEllipsoid(const std::vector<double>& x);
 double RotatedHyperEllipsoid(const std::vector<double>& x);
 double RosenbrockValley(const std::vector<double>& x);
 double Rastring(const std::vector<double>& x);
-double Schwefel(const std::vector<double> x);
+double Schwefel(const std::vector<double>& x);
 double Griewangk(const std::vector<double>& x);
 double SumDifferentPower(const std::vector<double>& x);
-std::function<double(std::vector<double>)> bindAckley(const std::vector<double>& a);
-std::function<double(std::vector<double>)> bindLangermann(const std::vector<std::vector<double>>& a, const std::vector<double>& c);
-std::function<double(std::vector<double>)> bindMichalewicz(const int& m);
-std::function<double(std::vector<double>)> bindBranin(const std::vector<double>& a);
-double Easom(const std::vector<double> x);
+std::function<double(const std::vector<double>&)> bindAckley(const std::vector<double>& a);
+std::function<double(const std::vector<double>&)> bindLangermann(const std::vector<std::vector<double>>& a, const std::vector<double>& c);
+std::function<double(const std::vector<double>&)> bindLangermann(const CoefficientSet& coefficients);
+std::function<double(const std::vector<double>&)> bindGriewangk(std::size_t dimension);
+std::function<double(const std::vector<double>&)> bindMichalewicz(const int& m);
+std::function<double(const std::vector<double>&)> bindBranin(const std::vector<double>& a);
+double Easom(const std::vector<double>& x);
 double GoldsteinPrice(const std::vector<double>& v);
-double SixHumpCamelBack(const std::vector<double> x);
-double FifthDeJong(const std::vector<double> x);
-double DropWave(const std::vector<double> x);
-double Shubert(const std::vector<double> x);
-std::function<double(std::vector<double>)> bindShekelFoxholes(const std::vector<std::vector<double>>& a, const std::vector<double>& c);
+double SixHumpCamelBack(const std::vector<double>& x);
+double FifthDeJong(const std::vector<double>& x);
+double DropWave(const std::vector<double>& x);
+double Shubert(const std::vector<double>& x);
+std::function<double(const std::vector<double>&)> bindShekelFoxholes(const std::vector<std::vector<double>>& a, const std::vector<double>& c);
+std::function<double(const std::vector<double>&)> bindShekelFoxholes(const CoefficientSet& coefficients);
 
 #endif
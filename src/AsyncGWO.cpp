@@ -0,0 +1,205 @@
+#include <vector>
+#include <functional>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+#include "AsyncGWO.hpp"
+#include "Pack.hpp"
+#include "Random.hpp"
+#include "Scheduler.hpp"
+#include "UpdateKernel.hpp"
+
+namespace {
+
+using gwo_detail::Clock;
+using gwo_detail::seconds_since;
+
+// A finished evaluation, posted by a worker
+struct Completion {
+    int wolf = 0;
+    double fitness = 0.0;
+    double seconds = 0.0;
+    std::exception_ptr error;
+};
+
+// Multiple-producer, single-consumer queue of finished evaluations
+class CompletionQueue {
+public:
+    void push(const Completion& completion) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            items_.push_back(completion);
+        }
+        ready_.notify_one();
+    }
+
+    Completion pop() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        ready_.wait(lock, [this] { return !items_.empty(); });
+        Completion completion = items_.front();
+        items_.pop_front();
+        return completion;
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable ready_;
+    std::deque<Completion> items_;
+};
+
+// Indices of the three fittest wolves, ties going to the lowest index, as in the
+// generational optimizer. Wolves not evaluated yet have the largest fitness, so
+// while fewer than three have been evaluated the missing leaders repeat the alpha.
+void select_leaders(const Pack& evaluated, int leaders[3]) {
+    leaders[0] = leaders[1] = leaders[2] = 0;
+    double fitness[3] = { std::numeric_limits<double>::max(), std::numeric_limits<double>::max(),
+                          std::numeric_limits<double>::max() };
+    for (int w = 0; w < static_cast<int>(evaluated.population()); ++w) {
+        int slot = 3;
+        while (slot > 0 && evaluated.fitness(w) < fitness[slot - 1]) {
+            --slot;
+        }
+        for (int k = 2; k > slot; --k) {
+            fitness[k] = fitness[k - 1];
+            leaders[k] = leaders[k - 1];
+        }
+        if (slot < 3) {
+            fitness[slot] = evaluated.fitness(w);
+            leaders[slot] = w;
+        }
+    }
+    for (int k = 1; k < 3; ++k) {
+        if (fitness[k] == std::numeric_limits<double>::max()) leaders[k] = leaders[0];
+    }
+}
+
+} // namespace
+
+std::pair<std::vector<double>, double> GreyWolfOptimizerAsync(
+    const std::function<double(const std::vector<double>&)>& function,
+    const std::vector<double>& lowerbound,
+    const std::vector<double>& upperbound,
+    int population, int max_evaluations, std::uint64_t seed,
+    std::size_t threads,
+    const std::function<double(int, int)>& compute_a,
+    GwoStats* stats)
+{
+    if (population < 3) {
+        throw std::invalid_argument("The pack needs at least 3 wolves.");
+    }
+    if (lowerbound.size() != upperbound.size()) {
+        throw std::invalid_argument("The lower and upper bounds must have the same size.");
+    }
+
+    const std::size_t dimension = lowerbound.size();
+    auto run_start = Clock::now();
+
+    Pack pack(population, dimension);
+    Pack evaluated(population, dimension);  // The last evaluated point of every wolf
+    std::vector<VectorRng> streams = make_streams(seed, population);
+
+    // Initialize wolves randomly
+    for (int w = 0; w < population; ++w) {
+        double* position = pack.position(w);
+        streams[w].fill_uniform(position, dimension);
+        for (std::size_t j = 0; j < dimension; ++j) {
+            position[j] = lowerbound[j] + position[j] * (upperbound[j] - lowerbound[j]);
+        }
+    }
+
+    // Declared before the pool, so it outlives the workers that post to it
+    CompletionQueue completions;
+    TaskScheduler pool(threads);
+
+    // A wolf's row is only written by this thread, and only while the wolf has no
+    // evaluation in flight; the queue orders the worker's read before that write
+    auto dispatch = [&](int wolf) {
+        pool.submit([&pack, &function, &completions, wolf, dimension] {
+            thread_local std::vector<double> scratch;
+            scratch.assign(pack.position(wolf), pack.position(wolf) + dimension);
+
+            Completion completion;
+            completion.wolf = wolf;
+            auto start = Clock::now();
+            try {
+                completion.fitness = function(scratch);
+            } catch (...) {
+                completion.error = std::current_exception();
+            }
+            completion.seconds = seconds_since(start);
+            completions.push(completion);
+        });
+    };
+
+    int dispatched = 0;
+    int completed = 0;
+    for (int w = 0; w < std::min(population, max_evaluations); ++w) {
+        dispatch(w);
+        ++dispatched;
+    }
+
+    // Track the best solution found
+    std::vector<double> best_position(pack.position(0), pack.position(0) + dimension);
+    double best_fitness = std::numeric_limits<double>::max();
+
+    GwoStats local_stats;
+    local_stats.stop_reason = StopReason::max_evaluations;
+    double busy_seconds = 0.0;
+    std::exception_ptr error;
+
+    while (completed < dispatched) {
+        Completion done = completions.pop();
+        ++completed;
+        busy_seconds += done.seconds;
+        if (done.error) {
+            // Stop dispatching and let the evaluations in flight finish
+            if (!error) error = done.error;
+            continue;
+        }
+        local_stats.evaluations += 1;
+
+        auto update_start = Clock::now();
+        const int w = done.wolf;
+        pack.fitness(w) = done.fitness;
+        pack.copy_to(w, evaluated, w);
+        if (done.fitness < best_fitness) {
+            best_fitness = done.fitness;
+            std::copy(pack.position(w), pack.position(w) + dimension, best_position.begin());
+        }
+
+        if (!error && dispatched < max_evaluations) {
+            // Alpha, Beta and Delta among the wolves' latest points, including the one just evaluated
+            int leaders[3];
+            select_leaders(evaluated, leaders);
+            LeaderPositions leader_positions = { evaluated.position(leaders[0]), evaluated.position(leaders[1]),
+                                                 evaluated.position(leaders[2]) };
+            double a = compute_a(max_evaluations, dispatched);
+
+            update_wolf(pack.position(w), leader_positions, lowerbound.data(), upperbound.data(), dimension, a, streams[w]);
+            dispatch(w);
+            ++dispatched;
+        }
+        local_stats.update_seconds += seconds_since(update_start);
+    }
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+
+    double run_seconds = seconds_since(run_start);
+    local_stats.evaluation_seconds = run_seconds;
+    local_stats.evaluation_wait_seconds = std::max(0.0, run_seconds * pool.size() - busy_seconds);
+    // Every wolf is evaluated as often as the others, give or take one, so a full pass
+    // over the pack counts as an iteration
+    local_stats.iterations = population > 0 ? static_cast<int>(local_stats.evaluations / population) : 0;
+    if (stats != nullptr) {
+        *stats = local_stats;
+    }
+
+    return { best_position, best_fitness };
+}
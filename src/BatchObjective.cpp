@@ -0,0 +1,23 @@
+#include <vector>
+#include <functional>
+#include <algorithm>
+
+#include "BatchObjective.hpp"
+
+BatchObjective make_batch_objective(std::function<double(const std::vector<double>&)> function) {
+    return [function = std::move(function)](const PopulationView& positions, Span<double> fitness) {
+        const int population = static_cast<int>(positions.population);
+
+        #pragma omp parallel
+        {
+            std::vector<double> scratch(positions.dimension);
+
+            #pragma omp for
+            for (int i = 0; i < population; ++i) {
+                Span<const double> row = positions.row(i);
+                std::copy(row.begin(), row.end(), scratch.begin());
+                fitness[i] = function(scratch);
+            }
+        }
+    };
+}
@@ -0,0 +1,1328 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <random>
+#include <chrono>
+#include <cmath>
+#include <algorithm>
+#include <array>
+#include <numeric>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <thread>
+
+#include <signal.h>
+#include <unistd.h>
+
+#include "AsyncGWO.hpp"
+#include "GWO.hpp"
+#include "GWOCore.hpp"
+#include "BenchmarkSuite.hpp"
+#include "Checkpoint.hpp"
+#include "CooperativeGWO.hpp"
+#include "IslandGWO.hpp"
+#include "ManyGWO.hpp"
+#include "Numa.hpp"
+#include "ProcessEvaluator.hpp"
+#include "Profiler.hpp"
+#include "CoefficientSet.hpp"
+#include "EvaluationCache.hpp"
+#include "FixedGWO.hpp"
+#include "ReferenceFunctions.hpp"
+#include "Telemetry.hpp"
+#include "functions.hpp"
+#include "TestSupport.hpp"
+#include "Pack.hpp"
+#include "Random.hpp"
+#include "UpdateKernel.hpp"
+#include "Simd.hpp"
+
+using namespace std;
+using Clock = chrono::steady_clock;
+
+// One measured configuration. The (suite, name, variant, population, dimension, threads)
+// tuple identifies it, so results of two commits can be joined and diffed on it.
+struct Record {
+    string suite;
+    string name;
+    string variant;
+    int population = 0;
+    int dimension = 0;
+    int threads = 0;
+    vector<pair<string, double>> metrics;
+};
+
+struct Options {
+    string format = "table";  // table, json or csv
+    string output;            // empty for stdout
+    bool quick = false;       // smaller problem sizes, for CI smoke runs
+    vector<string> suites;    // empty for every suite
+};
+
+double seconds_since(Clock::time_point start) {
+    return chrono::duration<double>(Clock::now() - start).count();
+}
+
+// ---------------------------------------------------------------------------
+// Objectives: cost of one evaluation of each benchmark function, optimized and reference
+// ---------------------------------------------------------------------------
+
+// Evaluation time of `func` over `points`, cycling through them for at least min_seconds
+pair<double, long long> time_objective(const function<double(const vector<double>&)>& func,
+                                       const vector<vector<double>>& points, double min_seconds) {
+    long long evaluations = 0;
+    volatile double sink = 0.0;
+    auto start = Clock::now();
+    double elapsed = 0.0;
+    do {
+        for (const auto& point : points) sink = sink + func(point);
+        evaluations += points.size();
+        elapsed = seconds_since(start);
+    } while (elapsed < min_seconds);
+    return { elapsed, evaluations };
+}
+
+// Times an optimized function and its reference on points of the optimized function's
+// domain, and records the largest relative difference between them
+void compare_objective(const BenchmarkFunction& optimized, const BenchmarkFunction& reference,
+                       const string& variant, double min_seconds, vector<Record>& records) {
+    // A fixed set of points inside the domain, cycled through during the measurement
+    mt19937 gen(42);
+    vector<vector<double>> points(64, vector<double>(optimized.lower_bound.size()));
+    for (auto& point : points) {
+        for (size_t j = 0; j < point.size(); ++j) {
+            uniform_real_distribution<double> dist(optimized.lower_bound[j], optimized.upper_bound[j]);
+            point[j] = dist(gen);
+        }
+    }
+
+    double max_error = 0.0;
+    for (const auto& point : points) {
+        max_error = max(max_error, relative_error(optimized.func(point), reference.func(point)));
+    }
+
+    for (const BenchmarkFunction* function : { &reference, &optimized }) {
+        auto [elapsed, evaluations] = time_objective(function->func, points, min_seconds);
+
+        Record record;
+        record.suite = "objectives";
+        record.name = optimized.name;
+        record.variant = function == &optimized ? variant : "reference";
+        record.dimension = static_cast<int>(optimized.lower_bound.size());
+        record.threads = 1;
+        record.metrics = {
+            { "ns_per_eval", elapsed * 1e9 / evaluations },
+            { "evals_per_sec", evaluations / elapsed }
+        };
+        if (function == &optimized) {
+            record.metrics.push_back({ "max_rel_error", max_error });
+        }
+        records.push_back(record);
+    }
+}
+
+// Shekel with a large random set of holes, saved to a file and evaluated from its mapping
+void compare_mapped_shekel(const Options& options, vector<Record>& records) {
+    const size_t holes = options.quick ? 2000 : 20000;
+    const size_t dimension = 4;
+
+    mt19937 gen(7);
+    uniform_real_distribution<double> position(0.0, 10.0), depth(0.1, 1.0);
+    vector<vector<double>> a(holes, vector<double>(dimension));
+    vector<double> c(holes);
+    for (size_t i = 0; i < holes; ++i) {
+        for (double& coordinate : a[i]) coordinate = position(gen);
+        c[i] = depth(gen);
+    }
+
+    string path = (filesystem::temp_directory_path() / ("gwo_shekel_" + to_string(getpid()) + ".bin")).string();
+    CoefficientSet(a, c).save(path);
+    CoefficientSet mapped = CoefficientSet::load(path);
+    filesystem::remove(path);  // The mapping stays valid after the file is unlinked
+
+    string name = "Shekel (" + to_string(holes) + " holes)";
+    BenchmarkFunction optimized = { bindShekelFoxholes(mapped), vector<double>(dimension, 0), vector<double>(dimension, 10), name };
+    BenchmarkFunction reference = { bind(reference::ShekelFoxholes, placeholders::_1, a, c), {}, {}, name };
+    compare_objective(optimized, reference, "mapped", options.quick ? 0.01 : 0.1, records);
+}
+
+void benchmark_objectives(const Options& options, vector<Record>& records) {
+    const int dimensions = 20;
+    const double min_seconds = options.quick ? 0.01 : 0.1;
+    const vector<BenchmarkFunction> optimized = make_benchmark_functions(dimensions);
+    const vector<BenchmarkFunction> references = make_reference_functions(dimensions);
+
+    for (size_t f = 0; f < optimized.size(); ++f) {
+        compare_objective(optimized[f], references[f], "optimized", min_seconds, records);
+    }
+    compare_mapped_shekel(options, records);
+}
+
+// ---------------------------------------------------------------------------
+// Kernel: the position update, per instruction set, against the original scalar path
+// ---------------------------------------------------------------------------
+
+// Fills a pack and its leaders with uniform positions inside [-5.12, 5.12]
+void fill_pack(Pack& pack, Pack& leaders, mt19937& gen) {
+    uniform_real_distribution<double> dist(-5.12, 5.12);
+    for (size_t w = 0; w < pack.population(); ++w) {
+        for (size_t j = 0; j < pack.dimension(); ++j) pack.position(w)[j] = dist(gen);
+    }
+    for (size_t w = 0; w < leaders.population(); ++w) {
+        for (size_t j = 0; j < leaders.dimension(); ++j) leaders.position(w)[j] = dist(gen);
+    }
+}
+
+// Nanoseconds per updated coordinate using the original scalar update_position path
+double time_reference(Pack pack, const Pack& leaders, const vector<double>& lower, const vector<double>& upper, int sweeps) {
+    mt19937 gen(7);
+    const double* alpha = leaders.position(0);
+    const double* beta = leaders.position(1);
+    const double* delta = leaders.position(2);
+
+    auto start = Clock::now();
+    for (int s = 0; s < sweeps; ++s) {
+        for (size_t w = 0; w < pack.population(); ++w) {
+            double* position = pack.position(w);
+            for (size_t j = 0; j < pack.dimension(); ++j) {
+                double X1 = update_position(position[j], alpha[j], 1.0, gen);
+                double X2 = update_position(position[j], beta[j], 1.0, gen);
+                double X3 = update_position(position[j], delta[j], 1.0, gen);
+                position[j] = clamp((X1 + X2 + X3) / 3.0, lower[j], upper[j]);
+            }
+        }
+    }
+    return seconds_since(start) * 1e9 / (double(sweeps) * pack.population() * pack.dimension());
+}
+
+// Nanoseconds per updated coordinate using the block kernel on a given instruction set
+double time_kernel(Pack& pack, const Pack& leaders, const vector<double>& lower, const vector<double>& upper, int sweeps, SimdIsa isa) {
+    VectorRng rng(7);
+    LeaderPositions leader_positions = { leaders.position(0), leaders.position(1), leaders.position(2) };
+
+    auto start = Clock::now();
+    for (int s = 0; s < sweeps; ++s) {
+        for (size_t w = 0; w < pack.population(); ++w) {
+            update_wolf(pack.position(w), leader_positions, lower.data(), upper.data(), pack.dimension(), 1.0, rng, isa);
+        }
+    }
+    return seconds_since(start) * 1e9 / (double(sweeps) * pack.population() * pack.dimension());
+}
+
+// Largest absolute difference between two packs
+double max_difference(const Pack& lhs, const Pack& rhs) {
+    double difference = 0.0;
+    for (size_t w = 0; w < lhs.population(); ++w) {
+        for (size_t j = 0; j < lhs.dimension(); ++j) {
+            difference = max(difference, fabs(lhs.position(w)[j] - rhs.position(w)[j]));
+        }
+    }
+    return difference;
+}
+
+void benchmark_update_kernel(const Options& options, vector<Record>& records) {
+    const int population = 20;
+    const vector<size_t> dimensions = options.quick ? vector<size_t>{ 64, 4096 } : vector<size_t>{ 16, 64, 256, 1024, 4096, 16384 };
+    const vector<SimdIsa> isas = { SimdIsa::Scalar, SimdIsa::Avx2, SimdIsa::Avx512 };
+    const double work = options.quick ? 1e6 : 4e6;
+
+    for (size_t dimension : dimensions) {
+        mt19937 gen(42);
+        Pack initial(population, dimension), leaders(3, dimension);
+        fill_pack(initial, leaders, gen);
+        vector<double> lower(dimension, -5.12), upper(dimension, 5.12);
+
+        // Keep the amount of work per measurement roughly constant
+        int sweeps = max<int>(1, static_cast<int>(work / (population * dimension)));
+        double reference = time_reference(initial, leaders, lower, upper, sweeps);
+
+        Record base;
+        base.suite = "kernel";
+        base.name = "update_wolf";
+        base.population = population;
+        base.dimension = static_cast<int>(dimension);
+        base.threads = 1;
+
+        Record record = base;
+        record.variant = "reference";
+        record.metrics = { { "ns_per_coord", reference }, { "speedup", 1.0 } };
+        records.push_back(record);
+
+        Pack scalar_result = initial;
+        for (SimdIsa isa : isas) {
+            if (!simd_isa_supported(isa)) continue;
+
+            Pack pack = initial;
+            double ns = time_kernel(pack, leaders, lower, upper, sweeps, isa);
+            if (isa == SimdIsa::Scalar) scalar_result = pack;
+
+            record = base;
+            record.variant = simd_isa_name(isa);
+            record.metrics = {
+                { "ns_per_coord", ns },
+                { "speedup", reference / ns },
+                { "max_abs_diff_vs_scalar", max_difference(pack, scalar_result) }
+            };
+            records.push_back(record);
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// End to end: whole optimizer runs at several population/dimension/thread points
+// ---------------------------------------------------------------------------
+
+vector<int> thread_counts() {
+    vector<int> counts;
+    for (int threads = 1; threads < max_threads(); threads *= 2) counts.push_back(threads);
+    counts.push_back(max_threads());
+    return counts;
+}
+
+template <typename Objective>
+void run_end_to_end(const Options& options, const string& name, const Objective& objective,
+                    double lower_bound, double upper_bound, vector<Record>& records) {
+    const vector<int> populations = options.quick ? vector<int>{ 20 } : vector<int>{ 20, 200 };
+    const vector<int> dimensions = options.quick ? vector<int>{ 30 } : vector<int>{ 30, 1000 };
+    const int iterations = options.quick ? 50 : 200;
+    const int default_threads = max_threads();
+
+    for (int population : populations) {
+        for (int dimension : dimensions) {
+            vector<double> lower(dimension, lower_bound), upper(dimension, upper_bound);
+
+            for (int threads : thread_counts()) {
+                set_threads(threads);
+                GwoWorkspace workspace;
+                GwoStats stats;
+
+                auto start = Clock::now();
+                auto result = GreyWolfOptimizerT(workspace, objective, lower, upper, population, iterations, 42, LinearSchedule(), &stats);
+                double elapsed = seconds_since(start);
+
+                Record record;
+                record.suite = "end_to_end";
+                record.name = name;
+                record.variant = "functor";
+                record.population = population;
+                record.dimension = dimension;
+                record.threads = threads;
+                record.metrics = {
+                    { "seconds", elapsed },
+                    { "ns_per_eval", elapsed * 1e9 / stats.evaluations },
+                    { "evals_per_sec", stats.evaluations / elapsed },
+                    { "iterations_per_sec", iterations / elapsed },
+                    { "evaluation_share", stats.evaluation_seconds / elapsed },
+                    { "update_share", stats.update_seconds / elapsed },
+                    { "evaluation_wait_seconds", stats.evaluation_wait_seconds },
+                    { "best_fitness", result.second }
+                };
+                records.push_back(record);
+            }
+        }
+    }
+    set_threads(default_threads);
+}
+
+void benchmark_end_to_end(const Options& options, vector<Record>& records) {
+    run_end_to_end(options, "Rastring", RastringObjective(), -5.12, 5.12, records);
+    run_end_to_end(options, "Rosenbrock Valley", RosenbrockValleyObjective(), -2.048, 2.048, records);
+    run_end_to_end(options, "Ackley", AckleyObjective({ 20, 0.2, 2 * M_PI }), -32.768, 32.768, records);
+}
+
+// ---------------------------------------------------------------------------
+// Precision: double against float positions, for the update kernel and whole runs
+// ---------------------------------------------------------------------------
+
+// Nanoseconds per updated coordinate of a pack stored in `Scalar`, large enough to
+// stream from memory rather than cache
+template <typename Scalar>
+double time_precision_kernel(size_t population, size_t dimension, int sweeps) {
+    BasicPack<Scalar> pack(population, dimension), leaders(3, dimension);
+    vector<Scalar> lower(dimension, Scalar(-5.12)), upper(dimension, Scalar(5.12));
+    for (BasicPack<Scalar>* target : { &pack, &leaders }) {
+        VectorRng fill(3);
+        for (size_t w = 0; w < target->population(); ++w) {
+            fill.fill_uniform(target->position(w), dimension);
+        }
+    }
+    VectorRng rng(7);
+    BasicLeaderPositions<Scalar> leader_positions = { leaders.position(0), leaders.position(1), leaders.position(2) };
+
+    auto start = Clock::now();
+    for (int s = 0; s < sweeps; ++s) {
+        for (size_t w = 0; w < population; ++w) {
+            update_wolf(pack.position(w), leader_positions, lower.data(), upper.data(), dimension, 1.0, rng);
+        }
+    }
+    return seconds_since(start) * 1e9 / (double(sweeps) * population * dimension);
+}
+
+// A whole run in a workspace of `Scalar` positions
+template <typename Scalar, typename Objective>
+void run_precision(const Options& options, const string& name, const Objective& objective,
+                   double bound, vector<Record>& records) {
+    const int population = 20;
+    const int dimension = options.quick ? 2000 : 100000;
+    const int iterations = options.quick ? 20 : 100;
+    const vector<double> lower(dimension, -bound), upper(dimension, bound);
+
+    BasicGwoWorkspace<Scalar> workspace;
+    GwoStats stats;
+    auto start = Clock::now();
+    auto [best_position, best_fitness] = GreyWolfOptimizerT(workspace, objective, lower, upper, population,
+                                                            iterations, 42, LinearSchedule(), &stats);
+    double elapsed = seconds_since(start);
+
+    Record record;
+    record.suite = "precision";
+    record.name = name;
+    record.variant = is_same_v<Scalar, float> ? "float" : "double";
+    record.population = population;
+    record.dimension = dimension;
+    record.threads = max_threads();
+    record.metrics = {
+        { "seconds", elapsed },
+        { "update_seconds", stats.update_seconds },
+        { "evaluation_seconds", stats.evaluation_seconds },
+        { "pack_bytes", static_cast<double>(population) * workspace.pack.stride() * sizeof(Scalar) },
+        { "best_fitness", best_fitness }
+    };
+    records.push_back(record);
+}
+
+void benchmark_precision(const Options& options, vector<Record>& records) {
+    const size_t population = 20;
+    const size_t dimension = options.quick ? 20000 : 200000;
+    const int sweeps = options.quick ? 5 : 20;
+
+    double double_ns = time_precision_kernel<double>(population, dimension, sweeps);
+    double float_ns = time_precision_kernel<float>(population, dimension, sweeps);
+    for (const string variant : { "double", "float" }) {
+        double ns = variant == "double" ? double_ns : float_ns;
+        Record record;
+        record.suite = "precision";
+        record.name = "update_wolf";
+        record.variant = variant;
+        record.population = static_cast<int>(population);
+        record.dimension = static_cast<int>(dimension);
+        record.threads = 1;
+        record.metrics = { { "ns_per_coord", ns }, { "speedup", double_ns / ns } };
+        records.push_back(record);
+    }
+
+    run_precision<double>(options, "Rastring", RastringObjective(), 5.12, records);
+    run_precision<float>(options, "Rastring", RastringObjective(), 5.12, records);
+    run_precision<double>(options, "DeJong", DeJongObjective(), 5.12, records);
+    run_precision<float>(options, "DeJong", DeJongObjective(), 5.12, records);
+}
+
+// ---------------------------------------------------------------------------
+// Fixed: the low-dimensional functions, general optimizer against the fixed-dimension one
+// ---------------------------------------------------------------------------
+
+// Many short runs of one problem through `GreyWolfOptimizerT` and `GreyWolfOptimizerFixed`,
+// each reusing its workspace, on one thread
+template <size_t Dim, typename Objective>
+void run_fixed(const Options& options, const string& name, const Objective& objective,
+               const array<double, Dim>& lower, const array<double, Dim>& upper, vector<Record>& records) {
+    const int population = 20;
+    const int iterations = options.quick ? 100 : 500;
+    const int runs = options.quick ? 20 : 200;
+    const vector<double> lower_vector(lower.begin(), lower.end()), upper_vector(upper.begin(), upper.end());
+
+    GwoWorkspace workspace;
+    vector<double> general_fitness(runs);
+    auto start = Clock::now();
+    for (int run = 0; run < runs; ++run) {
+        general_fitness[run] = GreyWolfOptimizerT(workspace, objective, lower_vector, upper_vector,
+                                                  population, iterations, run).second;
+    }
+    double general_seconds = seconds_since(start);
+
+    FixedGwoWorkspace<Dim> fixed_workspace;
+    vector<double> fixed_fitness(runs);
+    start = Clock::now();
+    for (int run = 0; run < runs; ++run) {
+        fixed_fitness[run] = GreyWolfOptimizerFixed(fixed_workspace, objective, lower, upper,
+                                                    population, iterations, run).second;
+    }
+    double fixed_seconds = seconds_since(start);
+
+    const double evaluations = double(runs) * population * iterations;
+    for (const string variant : { "general", "fixed" }) {
+        const bool fixed = variant == "fixed";
+        const double elapsed = fixed ? fixed_seconds : general_seconds;
+        const vector<double>& fitness = fixed ? fixed_fitness : general_fitness;
+
+        Record record;
+        record.suite = "fixed";
+        record.name = name;
+        record.variant = variant;
+        record.population = population;
+        record.dimension = static_cast<int>(Dim);
+        record.threads = 1;
+        record.metrics = {
+            { "runs_per_sec", runs / elapsed },
+            { "ns_per_eval", elapsed * 1e9 / evaluations },
+            { "speedup", general_seconds / elapsed },
+            { "mean_best_fitness", accumulate(fitness.begin(), fitness.end(), 0.0) / runs }
+        };
+        records.push_back(record);
+    }
+}
+
+void benchmark_fixed(const Options& options, vector<Record>& records) {
+    const int default_threads = max_threads();
+    set_threads(1);
+
+    const vector<double> branin_a = { 1, 1.275 * M_1_PI * M_1_PI, 5 * M_1_PI, 6, 10, 0.125 * M_1_PI };
+    const vector<vector<double>> langermann_a = { { 3, 5 }, { 5, 2 }, { 2, 1 }, { 1, 4 }, { 7, 9 } };
+    const vector<double> langermann_c = { 1, 2, 5, 2, 3 };
+    const vector<vector<double>> foxholes_a = {
+        { 4, 4, 4, 4 }, { 1, 1, 1, 1 }, { 8, 8, 8, 8 }, { 6, 6, 6, 6 }, { 3, 7, 3, 7 },
+        { 2, 9, 2, 9 }, { 5, 3, 5, 3 }, { 8, 1, 8, 1 }, { 6, 2, 6, 2 }, { 7, 3.6, 7, 3.6 }
+    };
+    const vector<double> foxholes_c = { 0.1, 0.2, 0.2, 0.4, 0.4, 0.6, 0.3, 0.7, 0.5, 0.5 };
+
+    using Bounds2 = array<double, 2>;
+    run_fixed(options, "Branin", BraninObjective(branin_a),
+              Bounds2{ -10, -10 }, Bounds2{ 10, 10 }, records);
+    run_fixed(options, "Goldstein-Price", GoldsteinPriceObjective(),
+              Bounds2{ -2, -2 }, Bounds2{ 2, 2 }, records);
+    run_fixed(options, "Six-Hump Camel", SixHumpCamelBackObjective(),
+              Bounds2{ -3, -2 }, Bounds2{ 3, 2 }, records);
+    run_fixed(options, "Fifth De Jong", FifthDeJongObjective(),
+              Bounds2{ -65.536, -65.536 }, Bounds2{ 65.536, 65.536 }, records);
+    run_fixed(options, "Drop Wave", DropWaveObjective(),
+              Bounds2{ -5.12, -5.12 }, Bounds2{ 5.12, 5.12 }, records);
+    run_fixed(options, "Shubert", ShubertObjective(),
+              Bounds2{ -5.12, -5.12 }, Bounds2{ 5.12, 5.12 }, records);
+    run_fixed(options, "Langermann", LangermannObjective(langermann_a, langermann_c),
+              Bounds2{ -10, -10 }, Bounds2{ 10, 10 }, records);
+    run_fixed(options, "Shekel", ShekelFoxholesObjective(foxholes_a, foxholes_c),
+              array<double, 4>{ 0, 0, 0, 0 }, array<double, 4>{ 10, 10, 10, 10 }, records);
+
+    set_threads(default_threads);
+}
+
+// ---------------------------------------------------------------------------
+// Many: a batch of small instances, one optimizer call each against one call for all
+// ---------------------------------------------------------------------------
+
+void benchmark_many(const Options& options, vector<Record>& records) {
+    const size_t instances = options.quick ? 64 : 2000;
+    const int population = 20;
+    const int iterations = options.quick ? 100 : 500;
+    const vector<double> lower = { -10, -10 }, upper = { 10, 10 };
+    StoppingCriteria criteria;
+    criteria.stagnation_iterations = iterations / 4;
+
+    const vector<BraninObjective> objectives = branin_instances(instances, 7);
+
+    // What a service does today: one call, with its own setup, per instance
+    vector<double> separate_fitness(instances);
+    auto start = Clock::now();
+    for (size_t k = 0; k < instances; ++k) {
+        separate_fitness[k] = GreyWolfOptimizerT(objectives[k], lower, upper, population, iterations, k,
+                                                 LinearSchedule(), nullptr, criteria).second;
+    }
+    double separate_seconds = seconds_since(start);
+
+    ManyGwoWorkspace workspace;
+    GreyWolfOptimizerMany(workspace, objectives, lower, upper, population, iterations, 42, LinearSchedule(), criteria);
+    start = Clock::now();
+    Span<const InstanceResult> results = GreyWolfOptimizerMany(workspace, objectives, lower, upper, population,
+                                                               iterations, 42, LinearSchedule(), criteria);
+    double batch_seconds = seconds_since(start);
+
+    vector<double> batch_fitness(instances);
+    long long stagnated = 0;
+    for (size_t k = 0; k < instances; ++k) {
+        batch_fitness[k] = results[k].best_fitness;
+        stagnated += results[k].stats.stop_reason == StopReason::stagnation;
+    }
+
+    for (const string variant : { "separate", "batch" }) {
+        const bool batch = variant == "batch";
+        const double elapsed = batch ? batch_seconds : separate_seconds;
+        const vector<double>& fitness = batch ? batch_fitness : separate_fitness;
+
+        Record record;
+        record.suite = "many";
+        record.name = "Branin";
+        record.variant = variant;
+        record.population = population;
+        record.dimension = 2;
+        record.threads = max_threads();
+        record.metrics = {
+            { "instances", static_cast<double>(instances) },
+            { "instances_per_sec", instances / elapsed },
+            { "speedup", separate_seconds / elapsed },
+            { "mean_best_fitness", accumulate(fitness.begin(), fitness.end(), 0.0) / instances }
+        };
+        if (batch) record.metrics.push_back({ "stagnated_instances", static_cast<double>(stagnated) });
+        records.push_back(record);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Cooperative: block-wise coevolution on separable objectives, with incremental and
+// full evaluation of each block change
+// ---------------------------------------------------------------------------
+
+void benchmark_cooperative(const Options& options, vector<Record>& records) {
+    const int population = 10;
+    const size_t block_size = 500;
+    const int cycles = options.quick ? 1 : 2;
+    const int block_iterations = options.quick ? 5 : 10;
+    // Incremental evaluation only reaches the large dimension in reasonable time
+    const size_t large_dimension = options.quick ? 100000 : 1000000;
+    const size_t small_dimension = options.quick ? 5000 : 20000;
+
+    CooperativeGwoWorkspace workspace;
+    auto run = [&](const string& name, const string& variant, size_t dimension, double bound, auto objective,
+                   auto evaluate) {
+        const vector<double> lower(dimension, -bound), upper(dimension, bound);
+        GwoStats stats;
+        auto start = Clock::now();
+        auto [context, fitness] = GreyWolfOptimizerCooperative(workspace, objective, lower, upper, block_size,
+                                                               population, cycles, block_iterations, 42,
+                                                               LinearSchedule(), &stats);
+        double elapsed = seconds_since(start);
+        double error = relative_error(fitness, evaluate(context));
+
+        Record record;
+        record.suite = "cooperative";
+        record.name = name;
+        record.variant = variant;
+        record.population = population;
+        record.dimension = static_cast<int>(dimension);
+        record.threads = max_threads();
+        record.metrics = {
+            { "seconds", elapsed },
+            { "block_evals_per_sec", stats.evaluations / elapsed },
+            { "best_fitness", fitness },
+            { "max_rel_error", error }
+        };
+        records.push_back(record);
+        return elapsed;
+    };
+
+    const RastringObjective rastring;
+    const DeJongObjective dejong;
+    const SchwefelObjective schwefel;
+    auto full_rastring = [&rastring](Span<const double> x) { return rastring(x); };
+
+    run("Rastring", "incremental", large_dimension, 5.12, rastring, rastring);
+    run("De Jong", "incremental", large_dimension, 5.12, dejong, dejong);
+    run("Schwefel", "incremental", large_dimension, 500, schwefel, schwefel);
+
+    // The same run without `partial`, where every block change costs a full evaluation
+    double incremental = run("Rastring", "incremental", small_dimension, 5.12, rastring, rastring);
+    double full = run("Rastring", "full", small_dimension, 5.12, full_rastring, rastring);
+    records.back().metrics.push_back({ "incremental_speedup", full / incremental });
+}
+
+// ---------------------------------------------------------------------------
+// NUMA: a memory-bound pack on one node and on all nodes, with and without the
+// NUMA-aware mode
+// ---------------------------------------------------------------------------
+
+// Both variants pin their threads compactly, so they differ only in where the pack and
+// the leaders live. On a single-node machine only the one-node runs are recorded.
+void benchmark_numa(const Options& options, vector<Record>& records) {
+    const int population = options.quick ? 64 : 512;
+    const int dimension = options.quick ? 1000 : 4000;
+    const int iterations = options.quick ? 10 : 50;
+    const vector<double> lower(dimension, -5.12), upper(dimension, 5.12);
+    const int default_threads = max_threads();
+    const NumaTopology topology = NumaTopology::detect();
+
+    vector<size_t> node_counts = { 1 };
+    if (topology.nodes() > 1) node_counts.push_back(topology.nodes());
+
+    double one_node_seconds[2] = {};
+    for (size_t nodes : node_counts) {
+        const NumaTopology used = topology.first_nodes(nodes);
+        const int threads = static_cast<int>(used.cpus());
+        const ThreadPlacement placement = pin_threads(used, ThreadPinning::compact, threads);
+
+        for (int aware = 0; aware < 2; ++aware) {
+            GwoWorkspace workspace;
+            if (aware) workspace.placement = &placement;
+
+            // The first run places the buffers; the second one is timed
+            GreyWolfOptimizerT(workspace, DeJongObjective(), lower, upper, population, iterations, 42);
+            auto start = Clock::now();
+            GreyWolfOptimizerT(workspace, DeJongObjective(), lower, upper, population, iterations, 42);
+            double elapsed = seconds_since(start);
+
+            if (nodes == 1) one_node_seconds[aware] = elapsed;
+
+            Record record;
+            record.suite = "numa";
+            record.name = "De Jong";
+            record.variant = aware ? "numa" : "default";
+            record.population = population;
+            record.dimension = dimension;
+            record.threads = threads;
+            record.metrics = {
+                { "nodes", static_cast<double>(nodes) },
+                { "seconds", elapsed },
+                { "iterations_per_sec", iterations / elapsed },
+                { "scaling", one_node_seconds[aware] / elapsed }
+            };
+            records.push_back(record);
+        }
+    }
+
+    unpin_threads();
+    set_threads(default_threads);
+}
+
+// ---------------------------------------------------------------------------
+// Async: generational vs steady-state runs on an objective with variable latency
+// ---------------------------------------------------------------------------
+
+// Rastring plus a sleep of 0.1 to 1 ms that depends on the point, standing in for a
+// simulation whose runtime varies by 10x. Sleeping rather than spinning keeps the
+// comparison meaningful when there are fewer cores than threads.
+double variable_latency_rastring(const vector<double>& x) {
+    uint64_t state = 0;
+    for (double xi : x) {
+        uint64_t bits;
+        memcpy(&bits, &xi, sizeof(bits));
+        state ^= bits;
+        state = splitmix64(state);
+    }
+    this_thread::sleep_for(chrono::microseconds(100 + state % 901));
+    return RastringObjective()(x);
+}
+
+void benchmark_async(const Options& options, vector<Record>& records) {
+    const int threads = 4;
+    const int population = 16;
+    const int iterations = options.quick ? 4 : 25;
+    const int dimension = 10;
+    const vector<double> lower(dimension, -5.12), upper(dimension, 5.12);
+    const function<double(const vector<double>&)> objective = variable_latency_rastring;
+    const int default_threads = max_threads();
+
+    for (const string variant : { "generational", "async" }) {
+        GwoStats stats;
+        auto start = Clock::now();
+        pair<vector<double>, double> result;
+        if (variant == "async") {
+            result = GreyWolfOptimizerAsync(objective, lower, upper, population, population * iterations, 42,
+                                            threads, compute_a, &stats);
+        } else {
+            set_threads(threads);
+            result = GreyWolfOptimizer(objective, lower, upper, population, iterations, 42, compute_a, &stats);
+            set_threads(default_threads);
+        }
+        double elapsed = seconds_since(start);
+
+        Record record;
+        record.suite = "async";
+        record.name = "Rastring (0.1-1 ms latency)";
+        record.variant = variant;
+        record.population = population;
+        record.dimension = dimension;
+        record.threads = threads;
+        record.metrics = {
+            { "seconds", elapsed },
+            { "evals_per_sec", stats.evaluations / elapsed },
+            { "idle_share", stats.evaluation_wait_seconds / (stats.evaluation_seconds * threads) },
+            { "best_fitness", result.second }
+        };
+        records.push_back(record);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Islands: one large pack against islands of the same total size, with and without migration
+// ---------------------------------------------------------------------------
+
+// Every variant evaluates the same number of points, so the best fitness compares the
+// quality each layout reaches for the same budget and the throughput its scaling
+void benchmark_islands(const Options& options, vector<Record>& records) {
+    const int islands = max(2, static_cast<int>(thread::hardware_concurrency()));
+    const int island_population = 20;
+    const int iterations = options.quick ? 100 : 1000;
+    const int dimension = 30;
+    const vector<double> lower(dimension, -5.12), upper(dimension, 5.12);
+    const function<double(const vector<double>&)> objective = Rastring;
+
+    struct Variant {
+        string name;
+        IslandTopology topology;
+        int migration_interval;
+    };
+    const vector<Variant> variants = {
+        { "single_pack", IslandTopology::ring, 0 },
+        { "isolated", IslandTopology::ring, 0 },
+        { "ring", IslandTopology::ring, 25 },
+        { "bidirectional", IslandTopology::bidirectional_ring, 25 },
+        { "fully_connected", IslandTopology::fully_connected, 25 }
+    };
+
+    for (const Variant& variant : variants) {
+        IslandStats stats;
+        auto start = Clock::now();
+        pair<vector<double>, double> result;
+        if (variant.name == "single_pack") {
+            result = GreyWolfOptimizer(objective, lower, upper, island_population * islands, iterations, 42,
+                                       compute_a, &stats.totals);
+        } else {
+            IslandOptions island_options;
+            island_options.islands = islands;
+            island_options.migration_interval = variant.migration_interval;
+            island_options.topology = variant.topology;
+            result = GreyWolfOptimizerIslands(objective, lower, upper, island_population, iterations, 42,
+                                              island_options, compute_a, &stats);
+        }
+        double elapsed = seconds_since(start);
+
+        Record record;
+        record.suite = "islands";
+        record.name = "Rastring, " + to_string(islands) + " x " + to_string(island_population) + " wolves";
+        record.variant = variant.name;
+        record.population = island_population * islands;
+        record.dimension = dimension;
+        record.threads = variant.name == "single_pack" ? max_threads() : islands;
+        record.metrics = {
+            { "seconds", elapsed },
+            { "evals_per_sec", stats.totals.evaluations / elapsed },
+            { "migrants_accepted", static_cast<double>(stats.migrants_accepted) },
+            { "best_fitness", result.second }
+        };
+        records.push_back(record);
+    }
+}
+
+#ifdef __linux__
+// ---------------------------------------------------------------------------
+// Processes: a non-thread-safe objective evaluated in forked worker processes
+// ---------------------------------------------------------------------------
+
+// Rastring through a global buffer, like a legacy objective that cannot run on two
+// threads at once, repeated so that one evaluation costs some tens of microseconds
+vector<double> legacy_buffer;
+
+double legacy_rastring(const vector<double>& x) {
+    double fitness = 0.0;
+    for (int repeat = 0; repeat < 50; ++repeat) {
+        legacy_buffer.assign(x.begin(), x.end());
+        fitness = RastringObjective()(legacy_buffer);
+    }
+    return fitness;
+}
+
+// Calls since the worker was forked; the parent never evaluates, so every replacement starts at 0
+long long legacy_calls = 0;
+
+double crashing_rastring(const vector<double>& x) {
+    if (++legacy_calls % 250 == 0) raise(SIGKILL);
+    return legacy_rastring(x);
+}
+
+// Runs the objective serially in-process and in a pool of worker processes, and once
+// more with workers that die every 250 evaluations
+void benchmark_processes(const Options& options, vector<Record>& records) {
+    const int workers = max(2, static_cast<int>(thread::hardware_concurrency()));
+    const int population = 32;
+    const int iterations = options.quick ? 20 : 200;
+    const int dimension = 30;
+    const vector<double> lower(dimension, -5.12), upper(dimension, 5.12);
+    const int default_threads = max_threads();
+
+    for (const string variant : { "serial", "processes", "crashing" }) {
+        ProcessEvaluatorStats process_stats;
+        auto start = Clock::now();
+        pair<vector<double>, double> result;
+        if (variant == "serial") {
+            set_threads(1);
+            const function<double(const vector<double>&)> objective = legacy_rastring;
+            result = GreyWolfOptimizerT(objective, lower, upper, population, iterations, 42);
+            set_threads(default_threads);
+        } else {
+            ProcessEvaluator evaluator(variant == "crashing" ? crashing_rastring : legacy_rastring,
+                                       dimension, population, workers);
+            result = GreyWolfOptimizerT(evaluator, lower, upper, population, iterations, 42);
+            process_stats = evaluator.stats();
+        }
+        double elapsed = seconds_since(start);
+
+        Record record;
+        record.suite = "processes";
+        record.name = "Rastring (global state)";
+        record.variant = variant;
+        record.population = population;
+        record.dimension = dimension;
+        record.threads = variant == "serial" ? 1 : workers;
+        record.metrics = {
+            { "seconds", elapsed },
+            { "evals_per_sec", static_cast<double>(population) * iterations / elapsed },
+            { "failures", static_cast<double>(process_stats.failures) },
+            { "restarts", static_cast<double>(process_stats.restarts) },
+            { "best_fitness", result.second }
+        };
+        records.push_back(record);
+    }
+}
+#endif
+
+// ---------------------------------------------------------------------------
+// Cache: objective calls saved by an evaluation cache
+// ---------------------------------------------------------------------------
+
+// A sphere centered outside the search box, so wolves that overshoot are clamped to the
+// same bound and the pack keeps evaluating identical points as it converges on the corner.
+void benchmark_cache(const Options& options, vector<Record>& records) {
+    const int population = 30;
+    const int iterations = options.quick ? 50 : 500;
+    const int dimension = 2;
+    const vector<double> lower(dimension, -5.0), upper(dimension, 5.0);
+
+    atomic<long long> calls{0};
+    const function<double(const vector<double>&)> objective = [&calls](const vector<double>& x) {
+        calls.fetch_add(1, memory_order_relaxed);
+        double sum = 0.0;
+        for (double xi : x) sum += (xi - 10.0) * (xi - 10.0);
+        return sum;
+    };
+
+    for (const string variant : { "uncached", "exact", "tolerance_1e-3" }) {
+        EvaluationCache cache(variant == "tolerance_1e-3" ? 1e-3 : 0.0);
+        const function<double(const vector<double>&)> evaluated =
+            variant == "uncached" ? objective : make_cached_objective(objective, cache);
+
+        calls = 0;
+        GwoStats stats;
+        auto start = Clock::now();
+        auto result = GreyWolfOptimizer(evaluated, lower, upper, population, iterations, 42, compute_a, &stats);
+        double elapsed = seconds_since(start);
+        EvaluationCacheStats cache_stats = cache.stats();
+
+        Record record;
+        record.suite = "cache";
+        record.name = "Shifted sphere";
+        record.variant = variant;
+        record.population = population;
+        record.dimension = dimension;
+        record.threads = max_threads();
+        record.metrics = {
+            { "seconds", elapsed },
+            { "evaluations", static_cast<double>(stats.evaluations) },
+            { "objective_calls", static_cast<double>(calls.load()) },
+            { "hit_rate", cache_stats.hit_rate() },
+            { "best_fitness", result.second }
+        };
+        records.push_back(record);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Stopping: iterations and evaluations used under each stopping criterion
+// ---------------------------------------------------------------------------
+
+// Runs each criterion alone on a problem where it is the first to trigger
+void benchmark_stopping(const Options& options, vector<Record>& records) {
+    const int population = 20;
+    const int dimension = 10;
+    const int iterations = options.quick ? 2000 : 20000;
+    const vector<double> lower(dimension, -5.12), upper(dimension, 5.12);
+
+    struct Case {
+        string name;
+        StopReason expected;
+        StoppingCriteria criteria;
+        bool multimodal;
+    };
+    vector<Case> cases(6);
+    cases[0] = { "none", StopReason::iterations, {}, false };
+    cases[1] = { "target 1e-8", StopReason::target_fitness, {}, false };
+    cases[1].criteria.target_fitness = 1e-8;
+    cases[2] = { "stagnation 50", StopReason::stagnation, {}, true };
+    cases[2].criteria.stagnation_iterations = 50;
+    cases[2].criteria.stagnation_tolerance = 1e-9;
+    cases[3] = { "diversity 1e-6", StopReason::diversity, {}, false };
+    cases[3].criteria.min_diversity = 1e-6;
+    cases[4] = { "1010 evaluations", StopReason::max_evaluations, {}, false };
+    cases[4].criteria.max_evaluations = 1010;
+    cases[5] = { "deadline 5 ms", StopReason::deadline, {}, true };
+    cases[5].criteria.max_seconds = 0.005;
+    // Without any criterion the run must go through every iteration, so keep it short;
+    // the deadline must come first even on a fast machine, so give it plenty
+    const int unbounded_iterations = 200;
+    const int deadline_iterations = 1000000;
+
+    for (const Case& test : cases) {
+        const function<double(const vector<double>&)> objective =
+            test.multimodal ? function<double(const vector<double>&)>(Rastring) : DeJong;
+        int cap = test.expected == StopReason::iterations ? unbounded_iterations
+                : test.expected == StopReason::deadline ? deadline_iterations : iterations;
+
+        GwoStats stats;
+        auto start = Clock::now();
+        auto result = GreyWolfOptimizer(objective, lower, upper, population, cap, 42, compute_a, &stats, test.criteria);
+        double elapsed = seconds_since(start);
+
+        Record record;
+        record.suite = "stopping";
+        record.name = test.name;
+        record.variant = to_string(stats.stop_reason);
+        record.population = population;
+        record.dimension = dimension;
+        record.threads = max_threads();
+        record.metrics = {
+            { "seconds", elapsed },
+            { "iterations", static_cast<double>(stats.iterations) },
+            { "evaluations", static_cast<double>(stats.evaluations) },
+            { "best_fitness", result.second }
+        };
+        records.push_back(record);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Checkpoint: cost of periodic snapshots, and resuming an interrupted run
+// ---------------------------------------------------------------------------
+
+// Times an uninterrupted run, the same run with snapshots, and the run interrupted
+// halfway through with an evaluation budget and resumed from its last checkpoint
+void benchmark_checkpoint(const Options& options, vector<Record>& records) {
+    const int population = 30;
+    const int dimension = options.quick ? 20 : 100;
+    const int iterations = options.quick ? 100 : 1000;
+    const int interval = 10;
+    const vector<double> lower(dimension, -5.12), upper(dimension, 5.12);
+    const function<double(const vector<double>&)> objective = Rastring;
+    const string path = (filesystem::temp_directory_path() / ("gwo_checkpoint_" + to_string(getpid()) + ".bin")).string();
+
+    auto run = [&](const string& variant, Checkpointer* checkpointer, const StoppingCriteria& criteria) {
+        GwoStats stats;
+        auto start = Clock::now();
+        auto result = GreyWolfOptimizer(objective, lower, upper, population, iterations, 42, compute_a, &stats,
+                                        criteria, checkpointer);
+        double elapsed = seconds_since(start);
+
+        Record record;
+        record.suite = "checkpoint";
+        record.name = "Rastring, every " + to_string(interval) + " iterations";
+        record.variant = variant;
+        record.population = population;
+        record.dimension = dimension;
+        record.threads = max_threads();
+        record.metrics = {
+            { "seconds", elapsed },
+            { "iterations", static_cast<double>(stats.iterations) },
+            { "evaluations", static_cast<double>(stats.evaluations) },
+            { "best_fitness", result.second }
+        };
+        records.push_back(record);
+    };
+
+    run("uninterrupted", nullptr, {});
+
+    filesystem::remove(path);
+    {
+        Checkpointer checkpointer(path, interval);
+        run("checkpointed", &checkpointer, {});
+    }
+
+    // Stop after a little more than half the iterations, then resume from the last snapshot
+    filesystem::remove(path);
+    StoppingCriteria interruption;
+    interruption.max_evaluations = static_cast<long long>(population) * (iterations / 2 + interval / 2);
+    {
+        Checkpointer checkpointer(path, interval);
+        run("interrupted", &checkpointer, interruption);
+    }
+    {
+        Checkpointer checkpointer(path, interval);
+        run("resumed", &checkpointer, {});
+    }
+    uintmax_t file_bytes = filesystem::file_size(path);
+    filesystem::remove(path);
+    records.back().metrics.push_back({ "file_bytes", static_cast<double>(file_bytes) });
+}
+
+// ---------------------------------------------------------------------------
+// Telemetry: overhead of streaming one sample per iteration to a file
+// ---------------------------------------------------------------------------
+
+// Runs a cheap objective, where the per-iteration work of the observer weighs the most,
+// with and without a telemetry stream
+void benchmark_telemetry(const Options& options, vector<Record>& records) {
+    const int population = 30;
+    const int dimension = 30;
+    const int iterations = options.quick ? 200 : 2000;
+    const vector<double> lower(dimension, -5.12), upper(dimension, 5.12);
+    const string path = (filesystem::temp_directory_path() / ("gwo_telemetry_" + to_string(getpid()))).string();
+
+    GwoWorkspace workspace;
+    for (const string variant : { "none", "csv", "binary" }) {
+        long long written = 0, dropped = 0;
+        auto start = Clock::now();
+        if (variant == "none") {
+            GreyWolfOptimizerT(workspace, RastringObjective(), lower, upper, population, iterations, 42);
+        } else {
+            TelemetryStream stream(path, variant == "csv" ? TelemetryFormat::csv : TelemetryFormat::binary);
+            GreyWolfOptimizerT(workspace, RastringObjective(), lower, upper, population, iterations, 42,
+                               LinearSchedule(), nullptr, StoppingCriteria(), nullptr, stream.observer());
+            stream.flush();
+            written = stream.written();
+            dropped = stream.dropped();
+        }
+        double elapsed = seconds_since(start);
+
+        Record record;
+        record.suite = "telemetry";
+        record.name = "Rastring";
+        record.variant = variant;
+        record.population = population;
+        record.dimension = dimension;
+        record.threads = max_threads();
+        record.metrics = {
+            { "seconds", elapsed },
+            { "us_per_iter", elapsed * 1e6 / iterations },
+            { "samples", static_cast<double>(written) },
+            { "dropped", static_cast<double>(dropped) }
+        };
+        records.push_back(record);
+    }
+    filesystem::remove(path);
+}
+
+// ---------------------------------------------------------------------------
+// Profile: cost of the built-in profiler
+// ---------------------------------------------------------------------------
+
+// Times runs where an iteration takes some tens of microseconds. Without GWO_PROFILE only
+// the uninstrumented time is recorded, to compare with a profiled build.
+void benchmark_profile(const Options& options, vector<Record>& records) {
+    const int population = 30;
+    const int dimension = 256;
+    const int iterations = options.quick ? 200 : 2000;
+    const int repeats = options.quick ? 3 : 7;
+    const vector<double> lower(dimension, -5.12), upper(dimension, 5.12);
+
+    GwoWorkspace workspace;
+    auto time_run = [&] {
+        auto start = Clock::now();
+        GreyWolfOptimizerT(workspace, RastringObjective(), lower, upper, population, iterations, 42);
+        return seconds_since(start);
+    };
+    auto add_record = [&](const string& variant, double seconds, vector<pair<string, double>> metrics) {
+        Record record;
+        record.suite = "profile";
+        record.name = "Rastring";
+        record.variant = variant;
+        record.population = population;
+        record.dimension = dimension;
+        record.threads = max_threads();
+        record.metrics = { { "seconds", seconds }, { "us_per_iter", seconds * 1e6 / iterations } };
+        record.metrics.insert(record.metrics.end(), metrics.begin(), metrics.end());
+        records.push_back(record);
+    };
+
+#ifdef GWO_PROFILE
+    Profiler& profiler = Profiler::instance();
+
+    // The phase shares of one run, from a clean profiler
+    profiler.set_enabled(true);
+    profiler.reset();
+    time_run();
+    const double evaluation_share = static_cast<double>(profiler.totals(ProfilePhase::evaluation).ticks)
+                                  / (profiler.totals(ProfilePhase::evaluation).ticks
+                                     + profiler.totals(ProfilePhase::update).ticks);
+
+    // Alternate disabled and enabled runs, and keep the fastest of each
+    double disabled = INFINITY, enabled = INFINITY;
+    for (int r = 0; r < repeats; ++r) {
+        profiler.set_enabled(false);
+        disabled = min(disabled, time_run());
+        profiler.set_enabled(true);
+        enabled = min(enabled, time_run());
+    }
+    profiler.reset();
+
+    add_record("disabled", disabled, {});
+    add_record("enabled", enabled, { { "overhead", enabled / disabled - 1.0 },
+                                     { "evaluation_share", evaluation_share } });
+#else
+    double compiled_out = INFINITY;
+    for (int r = 0; r < repeats; ++r) {
+        compiled_out = min(compiled_out, time_run());
+    }
+    add_record("compiled_out", compiled_out, {});
+#endif
+}
+
+// ---------------------------------------------------------------------------
+// Output
+// ---------------------------------------------------------------------------
+
+string json_string(const string& text) {
+    string escaped = "\"";
+    for (char c : text) {
+        if (c == '"' || c == '\\') escaped += '\\';
+        escaped += c;
+    }
+    return escaped + "\"";
+}
+
+string json_number(double value) {
+    if (!isfinite(value)) return "null";
+    ostringstream out;
+    out << setprecision(10) << value;
+    return out.str();
+}
+
+void write_json(ostream& out, const vector<Record>& records) {
+    out << "{\n  \"simd\": " << json_string(simd_isa_name(detect_simd_isa()))
+        << ",\n  \"max_threads\": " << max_threads() << ",\n  \"results\": [\n";
+    for (size_t i = 0; i < records.size(); ++i) {
+        const Record& r = records[i];
+        out << "    {\"suite\": " << json_string(r.suite) << ", \"name\": " << json_string(r.name)
+            << ", \"variant\": " << json_string(r.variant) << ", \"population\": " << r.population
+            << ", \"dimension\": " << r.dimension << ", \"threads\": " << r.threads << ", \"metrics\": {";
+        for (size_t m = 0; m < r.metrics.size(); ++m) {
+            out << (m ? ", " : "") << json_string(r.metrics[m].first) << ": " << json_number(r.metrics[m].second);
+        }
+        out << "}}" << (i + 1 < records.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+}
+
+// One row per metric, so that adding a metric never changes the columns
+void write_csv(ostream& out, const vector<Record>& records) {
+    out << "suite,name,variant,population,dimension,threads,metric,value\n";
+    for (const Record& r : records) {
+        for (const auto& [metric, value] : r.metrics) {
+            out << r.suite << ",\"" << r.name << "\"," << r.variant << "," << r.population << ","
+                << r.dimension << "," << r.threads << "," << metric << "," << setprecision(10) << value << "\n";
+        }
+    }
+}
+
+void write_table(ostream& out, const vector<Record>& records) {
+    out << "SIMD: " << simd_isa_name(detect_simd_isa()) << ", max threads: " << max_threads() << "\n";
+    string suite;
+    for (const Record& r : records) {
+        if (r.suite != suite) {
+            suite = r.suite;
+            out << "\n[" << suite << "]\n";
+        }
+        out << left << setw(30) << r.name << setw(15) << r.variant << right
+            << " P=" << setw(4) << r.population << " D=" << setw(6) << r.dimension << " T=" << setw(3) << r.threads;
+        for (const auto& [metric, value] : r.metrics) {
+            out << "  " << metric << "=" << setprecision(4) << value;
+        }
+        out << "\n";
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Suites
+// ---------------------------------------------------------------------------
+
+struct Suite {
+    const char* name;
+    void (*run)(const Options&, vector<Record>&);
+};
+
+const Suite suites[] = {
+    { "objectives", benchmark_objectives },
+    { "kernel", benchmark_update_kernel },
+    { "end_to_end", benchmark_end_to_end },
+    { "precision", benchmark_precision },
+    { "fixed", benchmark_fixed },
+    { "many", benchmark_many },
+    { "cooperative", benchmark_cooperative },
+    { "numa", benchmark_numa },
+    { "async", benchmark_async },
+    { "islands", benchmark_islands },
+#ifdef __linux__
+    { "processes", benchmark_processes },
+#endif
+    { "cache", benchmark_cache },
+    { "stopping", benchmark_stopping },
+    { "checkpoint", benchmark_checkpoint },
+    { "telemetry", benchmark_telemetry },
+    { "profile", benchmark_profile },
+};
+
+const Suite* find_suite(const string& name) {
+    for (const Suite& suite : suites) {
+        if (name == suite.name) return &suite;
+    }
+    return nullptr;
+}
+
+[[noreturn]] void usage(const char* program, int status) {
+    cerr << "Usage: " << program << " [--format=table|json|csv] [--output=FILE] [--quick] [--suite=SUITE,...]\nSuites:";
+    for (const Suite& suite : suites) cerr << " " << suite.name;
+    cerr << "\n";
+    exit(status);
+}
+
+Options parse_options(int argc, char** argv) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        string argument = argv[i];
+        if (argument.rfind("--format=", 0) == 0) {
+            options.format = argument.substr(9);
+        } else if (argument.rfind("--output=", 0) == 0) {
+            options.output = argument.substr(9);
+        } else if (argument.rfind("--suite=", 0) == 0) {
+            options.suites.clear();
+            stringstream list(argument.substr(8));
+            for (string suite; getline(list, suite, ',');) {
+                if (find_suite(suite) == nullptr) {
+                    cerr << "Unknown suite: " << suite << "\n";
+                    usage(argv[0], 2);
+                }
+                options.suites.push_back(suite);
+            }
+        } else if (argument == "--quick") {
+            options.quick = true;
+        } else {
+            usage(argv[0], argument == "--help" ? 0 : 2);
+        }
+    }
+    if (options.suites.empty()) {
+        for (const Suite& suite : suites) options.suites.push_back(suite.name);
+    }
+    return options;
+}
+
+int main(int argc, char** argv) {
+    Options options = parse_options(argc, argv);
+
+    vector<Record> records;
+    for (const string& suite : options.suites) {
+        find_suite(suite)->run(options, records);
+    }
+
+    ofstream file;
+    if (!options.output.empty()) file.open(options.output);
+    ostream& out = options.output.empty() ? cout : file;
+
+    if (options.format == "json") {
+        write_json(out, records);
+    } else if (options.format == "csv") {
+        write_csv(out, records);
+    } else {
+        write_table(out, records);
+    }
+    return 0;
+}
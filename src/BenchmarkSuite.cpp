@@ -0,0 +1,138 @@
+#include <vector>
+#include <functional>
+#include <string>
+#include <cmath>
+
+#include "BenchmarkSuite.hpp"
+#include "functions.hpp"
+#include "ReferenceFunctions.hpp"
+
+using namespace std;
+
+namespace {
+
+using Objective = function<double(const vector<double>&)>;
+
+// Definción de parámetros para la función objetivo de Ackley
+const vector<double> usual_ackley_a = {20, 0.2, 2 * M_PI};
+
+// Definición de parámetros para la función objetivo de Langermann
+const vector<vector<double>> usual_langermann_a = {{3, 5}, {5, 2}, {2, 1}, {1, 4}, {7, 9}};
+const vector<double> usual_langermann_c = {1, 2, 5, 2, 3};
+
+// Definición de parámetros para la función objetivo de Michalewicz
+const int usual_michalewicz_m = 10;
+
+// Definición de parámetros para la función objetivo de Branin
+const vector<double> usual_branin_a = {1, 1.275*M_1_PI*M_1_PI, 5*M_1_PI, 6, 10, 0.125 * M_1_PI};
+
+// Definición de parámetros para la función objetivo de Shekel
+const vector<vector<double>> usual_foxholes_a{
+    {4.0, 4.0, 4.0, 4.0}
+    ,{1.0, 1.0, 1.0, 1.0}
+    ,{8.0, 8.0, 8.0, 8.0}
+    ,{6.0, 6.0, 6.0, 6.0}
+    ,{3.0, 7.0, 3.0, 7.0}
+    ,{2.0, 9.0, 2.0, 9.0}
+    ,{5.0, 3.0, 5.0, 3.0}
+    ,{8.0, 1.0, 8.0, 1.0}
+    ,{6.0, 2.0, 6.0, 2.0}
+    ,{7.0, 3.6, 7.0, 3.6}
+};
+const vector<double> usual_foxholes_c {
+    0.1
+    ,0.2
+    ,0.2
+    ,0.4
+    ,0.4
+    ,0.6
+    ,0.3
+    ,0.7
+    ,0.5
+    ,0.5
+};
+
+// Asocia cada función, en el orden de la tabla, con su dominio de búsqueda
+vector<BenchmarkFunction> with_domains(int dimensions, const vector<Objective>& functions) {
+    int langermann_dimension = usual_langermann_a[0].size();
+    int foxholes_dimension = usual_foxholes_a[0].size();
+
+    // Definición de parámetros para la función objetivo de Six-Hump Camel Back
+    vector<double> lowerbound_six_hump_camel_back{-3, -2};
+    vector<double> upperbound_six_hump_camel_back{3, 2};
+
+    vector<BenchmarkFunction> domains = {
+        { nullptr, vector<double>(dimensions, -5.12), vector<double>(dimensions, 5.12), "De Jong" },
+        { nullptr, vector<double>(dimensions, -5.12), vector<double>(dimensions, 5.12), "Axis Parallel Hyper Ellipsoid" },
+        { nullptr, vector<double>(dimensions, -65.536), vector<double>(dimensions, 65.536), "Rotated Hyper Ellipsoid" },
+        { nullptr, vector<double>(dimensions, -2.048), vector<double>(dimensions, 2.048), "Rosenbrock Valley" },
+        { nullptr, vector<double>(dimensions, -5.12), vector<double>(dimensions, 5.12), "Rastring" },
+        { nullptr, vector<double>(dimensions, -500), vector<double>(dimensions, 500), "Schwefel" },
+        { nullptr, vector<double>(dimensions, -600), vector<double>(dimensions, 600), "Griewangk" },
+        { nullptr, vector<double>(dimensions, -1), vector<double>(dimensions, 1), "Sum of Different Power" },
+        { nullptr, vector<double>(dimensions, -32.768), vector<double>(dimensions, 32.768), "Ackley" },
+        { nullptr, vector<double>(langermann_dimension, -10), vector<double>(langermann_dimension, 10), "Langermann" },
+        { nullptr, vector<double>(dimensions, 0), vector<double>(dimensions, M_PI), "Michalewicz" },
+        { nullptr, vector<double>(2, -10), vector<double>(2, 10), "Branin" },
+        { nullptr, vector<double>(2, -2), vector<double>(2, 2), "Goldstein-Price" },
+        { nullptr, lowerbound_six_hump_camel_back, upperbound_six_hump_camel_back, "Six-Hump Camel" },
+        { nullptr, vector<double>(2, -65.536), vector<double>(2, 65.536), "Fifth De Jong" },
+        { nullptr, vector<double>(2, -5.12), vector<double>(2, 5.12), "Drop Wave" },
+        { nullptr, vector<double>(2, -5.12), vector<double>(2, 5.12), "Shubert" },
+        { nullptr, vector<double>(foxholes_dimension, 0), vector<double>(foxholes_dimension, 10), "Shekel" }
+    };
+    for (size_t i = 0; i < domains.size(); ++i) {
+        domains[i].func = functions[i];
+    }
+    return domains;
+}
+
+} // namespace
+
+vector<BenchmarkFunction> make_benchmark_functions(int dimensions) {
+    return with_domains(dimensions, {
+        DeJong,
+        AxisParallelHyperEllipsoid,
+        RotatedHyperEllipsoid,
+        RosenbrockValley,
+        Rastring,
+        Schwefel,
+        bindGriewangk(dimensions),
+        SumDifferentPower,
+        bindAckley(usual_ackley_a),
+        bindLangermann(usual_langermann_a, usual_langermann_c),
+        bindMichalewicz(usual_michalewicz_m),
+        bindBranin(usual_branin_a),
+        GoldsteinPrice,
+        SixHumpCamelBack,
+        FifthDeJong,
+        DropWave,
+        Shubert,
+        bindShekelFoxholes(usual_foxholes_a, usual_foxholes_c)
+    });
+}
+
+vector<BenchmarkFunction> make_reference_functions(int dimensions) {
+    using namespace std::placeholders;
+
+    return with_domains(dimensions, {
+        reference::DeJong,
+        reference::AxisParallelHyperEllipsoid,
+        reference::RotatedHyperEllipsoid,
+        reference::RosenbrockValley,
+        reference::Rastring,
+        reference::Schwefel,
+        reference::Griewangk,
+        reference::SumDifferentPower,
+        bind(reference::Ackley, _1, usual_ackley_a),
+        bind(reference::Langermann, _1, usual_langermann_a, usual_langermann_c),
+        bind(reference::Michalewicz, _1, usual_michalewicz_m),
+        bind(reference::Branin, _1, usual_branin_a),
+        reference::GoldsteinPrice,
+        reference::SixHumpCamelBack,
+        reference::FifthDeJong,
+        reference::DropWave,
+        reference::Shubert,
+        bind(reference::ShekelFoxholes, _1, usual_foxholes_a, usual_foxholes_c)
+    });
+}
@@ -0,0 +1,283 @@
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "Checkpoint.hpp"
+#include "Random.hpp"
+
+namespace {
+
+// File layout: this 64-byte header, the scalar block, then the best position, the
+// positions, the fitnesses and the random states. Values are in native byte order.
+// The checksum covers everything after the header.
+struct FileHeader {
+    char magic[8];
+    std::uint64_t version;
+    std::uint64_t seed;
+    std::uint64_t population;
+    std::uint64_t dimension;
+    std::uint64_t iter;
+    std::uint64_t next_iteration;
+    std::uint64_t checksum;
+};
+
+struct ScalarBlock {
+    std::int64_t evaluations;
+    std::int64_t iterations;
+    double best_fitness;
+    double stagnation_reference;
+    std::int64_t stagnation_started;
+    std::int64_t stagnant_iterations;
+};
+
+static_assert(sizeof(FileHeader) == 64, "The header must stay 64 bytes");
+
+constexpr char file_magic[8] = { 'G', 'W', 'O', 'C', 'K', 'P', 'T', '\0' };
+constexpr std::uint64_t file_version = 1;
+
+// Words of random state per wolf
+constexpr std::size_t rng_words = 4 * VectorRng::lanes;
+
+std::runtime_error file_error(const std::string& path, const std::string& what) {
+    return std::runtime_error("Checkpoint file " + path + ": " + what);
+}
+
+// Hash of a byte range, one 64-bit word at a time
+class Checksum {
+public:
+    void add(const void* data, std::size_t bytes) {
+        const unsigned char* cursor = static_cast<const unsigned char*>(data);
+        for (; bytes >= sizeof(std::uint64_t); bytes -= sizeof(std::uint64_t), cursor += sizeof(std::uint64_t)) {
+            std::uint64_t word;
+            std::memcpy(&word, cursor, sizeof(word));
+            state_ ^= word;
+            state_ = splitmix64(state_);
+        }
+        for (; bytes > 0; --bytes, ++cursor) {
+            state_ ^= *cursor;
+            state_ = splitmix64(state_);
+        }
+    }
+
+    std::uint64_t value() const { return state_; }
+
+private:
+    std::uint64_t state_ = 0;
+};
+
+// The sections after the header, in file order
+template <typename State, typename Block>
+auto sections(State& state, Block& block) {
+    using Byte = std::conditional_t<std::is_const_v<State>, const char, char>;
+    return std::vector<std::pair<Byte*, std::size_t>>{
+        { reinterpret_cast<Byte*>(&block), sizeof(block) },
+        { reinterpret_cast<Byte*>(state.best_position.data()), state.best_position.size() * sizeof(double) },
+        { reinterpret_cast<Byte*>(state.positions.data()), state.positions.size() * sizeof(double) },
+        { reinterpret_cast<Byte*>(state.fitness.data()), state.fitness.size() * sizeof(double) },
+        { reinterpret_cast<Byte*>(state.rng_state.data()), state.rng_state.size() * sizeof(std::uint64_t) },
+    };
+}
+
+void write_all(int fd, const char* data, std::size_t bytes, const std::string& path) {
+    while (bytes > 0) {
+        ssize_t written = ::write(fd, data, bytes);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            throw file_error(path, std::strerror(errno));
+        }
+        data += written;
+        bytes -= static_cast<std::size_t>(written);
+    }
+}
+
+void read_all(int fd, char* data, std::size_t bytes, const std::string& path) {
+    while (bytes > 0) {
+        ssize_t count = ::read(fd, data, bytes);
+        if (count < 0) {
+            if (errno == EINTR) continue;
+            throw file_error(path, std::strerror(errno));
+        }
+        if (count == 0) {
+            throw file_error(path, "truncated");
+        }
+        data += count;
+        bytes -= static_cast<std::size_t>(count);
+    }
+}
+
+// Closes the descriptor on every path out of a scope
+struct FileDescriptor {
+    int fd;
+    ~FileDescriptor() { if (fd >= 0) ::close(fd); }
+};
+
+} // namespace
+
+void write_checkpoint(const std::string& path, const GwoCheckpoint& state) {
+    ScalarBlock block = { state.evaluations, state.iterations, state.best_fitness, state.stagnation_reference,
+                          state.stagnation_started ? 1 : 0, state.stagnant_iterations };
+    auto parts = sections(state, block);
+
+    FileHeader header = {};
+    std::memcpy(header.magic, file_magic, sizeof(file_magic));
+    header.version = file_version;
+    header.seed = state.seed;
+    header.population = state.population;
+    header.dimension = state.dimension;
+    header.iter = state.iter;
+    header.next_iteration = state.next_iteration;
+    Checksum checksum;
+    for (const auto& [data, bytes] : parts) checksum.add(data, bytes);
+    header.checksum = checksum.value();
+
+    const std::string temporary = path + ".tmp";
+    {
+        FileDescriptor file{ ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644) };
+        if (file.fd < 0) {
+            throw file_error(temporary, std::strerror(errno));
+        }
+        write_all(file.fd, reinterpret_cast<const char*>(&header), sizeof(header), temporary);
+        for (const auto& [data, bytes] : parts) write_all(file.fd, data, bytes, temporary);
+        // The data must be on disk before the rename makes it the checkpoint
+        if (::fsync(file.fd) != 0) {
+            throw file_error(temporary, std::strerror(errno));
+        }
+    }
+    if (std::rename(temporary.c_str(), path.c_str()) != 0) {
+        throw file_error(path, std::strerror(errno));
+    }
+}
+
+bool read_checkpoint(const std::string& path, GwoCheckpoint& state) {
+    FileDescriptor file{ ::open(path.c_str(), O_RDONLY | O_CLOEXEC) };
+    if (file.fd < 0) {
+        if (errno == ENOENT) return false;
+        throw file_error(path, std::strerror(errno));
+    }
+
+    FileHeader header;
+    read_all(file.fd, reinterpret_cast<char*>(&header), sizeof(header), path);
+    if (std::memcmp(header.magic, file_magic, sizeof(file_magic)) != 0) {
+        throw file_error(path, "not a checkpoint");
+    }
+    if (header.version != file_version) {
+        throw file_error(path, "unsupported version " + std::to_string(header.version));
+    }
+    struct stat info;
+    if (::fstat(file.fd, &info) != 0) {
+        throw file_error(path, std::strerror(errno));
+    }
+    // Bound the counts by the file size before multiplying them, so a corrupt header
+    // cannot wrap the expected size around to the real one
+    const std::uint64_t size = static_cast<std::uint64_t>(info.st_size);
+    const std::uint64_t fixed = sizeof(FileHeader) + sizeof(ScalarBlock);
+    const std::uint64_t payload = size > fixed ? size - fixed : 0;
+    if (header.dimension > payload / sizeof(double)
+        || header.population > payload / ((header.dimension + 1) * sizeof(double) + rng_words * sizeof(std::uint64_t))) {
+        throw file_error(path, "size does not match its header");
+    }
+    const std::uint64_t expected = fixed
+        + (header.dimension + header.population * (header.dimension + 1)) * sizeof(double)
+        + header.population * rng_words * sizeof(std::uint64_t);
+    if (size != expected) {
+        throw file_error(path, "size does not match its header");
+    }
+
+    // Read into a copy, so a corrupt file leaves `state` untouched
+    GwoCheckpoint loaded;
+    loaded.best_position.resize(header.dimension);
+    loaded.positions.resize(header.population * header.dimension);
+    loaded.fitness.resize(header.population);
+    loaded.rng_state.resize(header.population * rng_words);
+    ScalarBlock block;
+    auto parts = sections(loaded, block);
+    Checksum checksum;
+    for (const auto& [data, bytes] : parts) {
+        read_all(file.fd, data, bytes, path);
+        checksum.add(data, bytes);
+    }
+    if (checksum.value() != header.checksum) {
+        throw file_error(path, "checksum mismatch");
+    }
+
+    loaded.seed = header.seed;
+    loaded.population = header.population;
+    loaded.dimension = header.dimension;
+    loaded.iter = header.iter;
+    loaded.next_iteration = header.next_iteration;
+    loaded.evaluations = block.evaluations;
+    loaded.iterations = static_cast<int>(block.iterations);
+    loaded.best_fitness = block.best_fitness;
+    loaded.stagnation_reference = block.stagnation_reference;
+    loaded.stagnation_started = block.stagnation_started != 0;
+    loaded.stagnant_iterations = static_cast<int>(block.stagnant_iterations);
+    state = std::move(loaded);
+    return true;
+}
+
+Checkpointer::Checkpointer(std::string path, int interval)
+    : path_(std::move(path)), interval_(interval) {
+    writer_ = std::thread([this] { run(); });
+}
+
+Checkpointer::~Checkpointer() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    changed_.notify_all();
+    writer_.join();
+}
+
+void Checkpointer::save(const GwoCheckpoint& state) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (error_) {
+        std::rethrow_exception(std::exchange(error_, nullptr));
+    }
+    // Assignment reuses the buffers of the previous snapshot
+    pending_ = state;
+    has_pending_ = true;
+    changed_.notify_all();
+}
+
+void Checkpointer::flush() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    changed_.wait(lock, [this] { return !has_pending_ && !busy_; });
+    if (error_) {
+        std::rethrow_exception(std::exchange(error_, nullptr));
+    }
+}
+
+void Checkpointer::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        changed_.wait(lock, [this] { return has_pending_ || stop_; });
+        if (!has_pending_) return;  // Stopping, with everything written
+
+        std::swap(pending_, writing_);
+        has_pending_ = false;
+        busy_ = true;
+        lock.unlock();
+
+        std::exception_ptr error;
+        try {
+            write_checkpoint(path_, writing_);
+        } catch (...) {
+            error = std::current_exception();
+        }
+
+        lock.lock();
+        busy_ = false;
+        if (error) error_ = error;
+        changed_.notify_all();
+    }
+}
@@ -0,0 +1,135 @@
+#include <cstdint>
+#include <cstring>
+#include <cerrno>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "CoefficientSet.hpp"
+#include "Pack.hpp"
+
+namespace {
+
+// File layout: this 64-byte header, then (dimension + 1) * stride doubles laid out as
+// in memory, so the mapping can be used in place. Values are in native byte order.
+struct FileHeader {
+    char magic[8];
+    std::uint64_t version;
+    std::uint64_t size;
+    std::uint64_t dimension;
+    std::uint64_t stride;
+    std::uint64_t reserved[3];
+};
+
+static_assert(sizeof(FileHeader) == 64, "The data must start on a cache line");
+
+constexpr char file_magic[8] = { 'G', 'W', 'O', 'C', 'O', 'E', 'F', '\0' };
+constexpr std::uint64_t file_version = 1;
+
+std::size_t padded(std::size_t count) {
+    return (count + CoefficientSet::row_alignment - 1) / CoefficientSet::row_alignment * CoefficientSet::row_alignment;
+}
+
+std::runtime_error file_error(const std::string& path, const std::string& what) {
+    return std::runtime_error("Coefficient file " + path + ": " + what);
+}
+
+} // namespace
+
+CoefficientSet::CoefficientSet(const std::vector<std::vector<double>>& centers, const std::vector<double>& weights)
+    : size_(centers.size()),
+      dimension_(centers.empty() ? 0 : centers[0].size()),
+      stride_(padded(centers.size())) {
+    if (weights.size() != size_) {
+        throw std::invalid_argument("Dimension mismatch: there must be one weight per center.");
+    }
+
+    auto buffer = std::make_shared<AlignedVector<double>>((dimension_ + 1) * stride_, 0.0);
+    double* values = buffer->data();
+    for (std::size_t i = 0; i < size_; ++i) {
+        if (centers[i].size() != dimension_) {
+            throw std::invalid_argument("Dimension mismatch: all centers must have the same size.");
+        }
+        for (std::size_t j = 0; j < dimension_; ++j) {
+            values[j * stride_ + i] = centers[i][j];
+        }
+        values[dimension_ * stride_ + i] = weights[i];
+    }
+    data_ = std::shared_ptr<const double>(buffer, buffer->data());
+}
+
+CoefficientSet CoefficientSet::load(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        throw file_error(path, std::strerror(errno));
+    }
+    struct stat info;
+    if (::fstat(fd, &info) != 0) {
+        int error = errno;
+        ::close(fd);
+        throw file_error(path, std::strerror(error));
+    }
+    const std::size_t length = static_cast<std::size_t>(info.st_size);
+    if (length < sizeof(FileHeader)) {
+        ::close(fd);
+        throw file_error(path, "too short for a header");
+    }
+
+    void* mapping = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    int error = errno;
+    ::close(fd);  // The mapping keeps the file open
+    if (mapping == MAP_FAILED) {
+        throw file_error(path, std::strerror(error));
+    }
+    // Owned from here on, so any error below unmaps it
+    std::shared_ptr<const char> bytes(static_cast<const char*>(mapping),
+        [length](const char* address) { ::munmap(const_cast<char*>(address), length); });
+
+    FileHeader header;
+    std::memcpy(&header, bytes.get(), sizeof(header));
+    if (std::memcmp(header.magic, file_magic, sizeof(file_magic)) != 0) {
+        throw file_error(path, "not a coefficient set");
+    }
+    if (header.version != file_version) {
+        throw file_error(path, "unsupported version " + std::to_string(header.version));
+    }
+    if (header.stride != padded(header.size)
+        || length != sizeof(FileHeader) + (header.dimension + 1) * header.stride * sizeof(double)) {
+        throw file_error(path, "size does not match its header");
+    }
+
+    CoefficientSet set;
+    set.size_ = header.size;
+    set.dimension_ = header.dimension;
+    set.stride_ = header.stride;
+    set.mapped_ = true;
+    // mmap returns a page-aligned address and the header is 64 bytes, so the data is aligned
+    set.data_ = std::shared_ptr<const double>(bytes, reinterpret_cast<const double*>(bytes.get() + sizeof(FileHeader)));
+    return set;
+}
+
+void CoefficientSet::save(const std::string& path) const {
+    FileHeader header = {};
+    std::memcpy(header.magic, file_magic, sizeof(file_magic));
+    header.version = file_version;
+    header.size = size_;
+    header.dimension = dimension_;
+    header.stride = stride_;
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    if (data_) {
+        file.write(reinterpret_cast<const char*>(data_.get()),
+                   static_cast<std::streamsize>((dimension_ + 1) * stride_ * sizeof(double)));
+    }
+    file.close();
+    if (!file) {
+        throw file_error(path, "write failed");
+    }
+}
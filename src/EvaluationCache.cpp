@@ -0,0 +1,126 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+#include "EvaluationCache.hpp"
+#include "Random.hpp"
+
+EvaluationCache::EvaluationCache(double tolerance, std::size_t capacity, std::size_t shards)
+    : tolerance_(tolerance) {
+    if (!(tolerance >= 0.0)) {
+        throw std::invalid_argument("The cache tolerance must be non-negative.");
+    }
+    shards = std::max<std::size_t>(1, std::min(shards, std::max<std::size_t>(1, capacity)));
+    shard_capacity_ = std::max<std::size_t>(1, capacity / shards);
+
+    shards_.reserve(shards);
+    for (std::size_t i = 0; i < shards; ++i) {
+        shards_.push_back(std::make_unique<Shard>());
+    }
+}
+
+std::size_t EvaluationCache::KeyHash::operator()(const Key& key) const {
+    std::uint64_t state = key.size();
+    for (std::int64_t value : key) {
+        state ^= static_cast<std::uint64_t>(value);
+        state = splitmix64(state);
+    }
+    return static_cast<std::size_t>(state);
+}
+
+// Rounds every coordinate to the grid; returns false if one cannot be represented
+bool EvaluationCache::quantize(Span<const double> position, Key& key) const {
+    // Beyond 2^62 grid steps the rounded value no longer fits an int64 comfortably
+    constexpr double limit = 4.6e18;
+    key.resize(position.size());
+
+    for (std::size_t j = 0; j < position.size(); ++j) {
+        double value = position[j];
+        if (tolerance_ == 0.0) {
+            // Exact matching: the bit pattern, with -0 folded into +0
+            value += 0.0;
+            if (std::isnan(value)) return false;
+            std::int64_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            key[j] = bits;
+        } else {
+            double steps = std::nearbyint(value / tolerance_);
+            if (!(std::abs(steps) < limit)) return false;
+            key[j] = static_cast<std::int64_t>(steps);
+        }
+    }
+    return true;
+}
+
+EvaluationCache::Shard& EvaluationCache::shard_of(const Key& key) {
+    // The high bits, so that the shard index is independent of the bucket index
+    return *shards_[(KeyHash()(key) >> 40) % shards_.size()];
+}
+
+double EvaluationCache::get_or_evaluate(Span<const double> position, const std::function<double()>& evaluate) {
+    // Quantized into a per-thread buffer, so that a hit does not allocate
+    thread_local Key buffer;
+    if (!quantize(position, buffer)) {
+        bypassed_.fetch_add(1, std::memory_order_relaxed);
+        return evaluate();
+    }
+
+    Shard& shard = shard_of(buffer);
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto found = shard.index.find(buffer);
+        if (found != shard.index.end()) {
+            // Move to the front of the LRU list
+            shard.entries.splice(shard.entries.begin(), shard.entries, found->second);
+            hits_.fetch_add(1, std::memory_order_relaxed);
+            return found->second->second;
+        }
+    }
+
+    // `evaluate` may look up another cache on this thread and overwrite the buffer
+    Key key = buffer;
+    misses_.fetch_add(1, std::memory_order_relaxed);
+    double fitness = evaluate();
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    if (shard.index.find(key) == shard.index.end()) {
+        shard.entries.emplace_front(key, fitness);
+        shard.index.emplace(std::move(key), shard.entries.begin());
+        if (shard.entries.size() > shard_capacity_) {
+            shard.index.erase(shard.entries.back().first);
+            shard.entries.pop_back();
+            evictions_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    return fitness;
+}
+
+void EvaluationCache::clear() {
+    for (auto& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        shard->index.clear();
+        shard->entries.clear();
+    }
+}
+
+EvaluationCacheStats EvaluationCache::stats() const {
+    EvaluationCacheStats stats;
+    stats.hits = hits_.load(std::memory_order_relaxed);
+    stats.misses = misses_.load(std::memory_order_relaxed);
+    stats.bypassed = bypassed_.load(std::memory_order_relaxed);
+    stats.evictions = evictions_.load(std::memory_order_relaxed);
+    for (const auto& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        stats.size += shard->entries.size();
+    }
+    return stats;
+}
+
+std::function<double(const std::vector<double>&)> make_cached_objective(
+    std::function<double(const std::vector<double>&)> function, EvaluationCache& cache) {
+    return [function = std::move(function), &cache](const std::vector<double>& x) {
+        return cache.get_or_evaluate(x, [&function, &x] { return function(x); });
+    };
+}
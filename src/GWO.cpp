@@ -3,31 +3,26 @@
 #include <cmath>
 #include <functional>
 #include <random>
-#include <array>
-#include <omp.h>
 
-// Structure to represent a single wolf
-struct Wolf {
-    std::vector<double> position;
-    double fitness;
+#include "GWO.hpp"
+#include "GWOCore.hpp"
 
-    Wolf() : fitness(std::numeric_limits<double>::max()) {}
+Wolf::Wolf() : fitness(std::numeric_limits<double>::max()) {}
 
-    Wolf(const std::vector<double>& lower_bound, const std::vector<double>& upper_bound, std::mt19937& gen) {
-        std::uniform_real_distribution<double> dist(0.0, 1.0);
-        position.resize(lower_bound.size());
-
-        for (size_t i = 0; i < position.size(); ++i) {
-            position[i] = lower_bound[i] + dist(gen) * (upper_bound[i] - lower_bound[i]);
-        }
+Wolf::Wolf(const std::vector<double>& lower_bound, const std::vector<double>& upper_bound, std::mt19937& gen) {
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+    position.resize(lower_bound.size());
 
-        fitness = std::numeric_limits<double>::max();
+    for (size_t i = 0; i < position.size(); ++i) {
+        position[i] = lower_bound[i] + dist(gen) * (upper_bound[i] - lower_bound[i]);
     }
 
-    bool operator<(const Wolf& other) const {
-        return fitness < other.fitness;
-    }
-};
+    fitness = std::numeric_limits<double>::max();
+}
+
+bool Wolf::operator<(const Wolf& other) const {
+    return fitness < other.fitness;
+}
 
 // Compute the `a` parameter that decreases over iterations
 /**
@@ -41,10 +36,11 @@ struct Wolf {
  * @return The computed value of `a`.
  */
 double compute_a(int iter, int current_iter) {
-    return 2.0 * (1 - static_cast<double>(current_iter) / iter);
+    return LinearSchedule()(iter, current_iter);
 }
 
 // Update a wolf’s position based on the leader’s influence
+// (scalar reference; the optimizer uses the block kernels in UpdateKernel.cpp)
 double update_position(double wolf_pos, double leader_pos, double a, std::mt19937& gen) {
     std::uniform_real_distribution<double> dist(0.0, 1.0);
     double r1 = dist(gen);
@@ -73,8 +69,8 @@ double update_position(double wolf_pos, double leader_pos, double a, std::mt1993
  * @param upperbound A vector containing the upper bounds for each dimension of the search space.
  * @param population The number of wolves in the pack.
  * @param iter The number of iterations (generations) to run the optimization process.
- * @param gen A random number generator (std::mt19937) used for generating random values in 
- *            the update process and initializing the wolves' positions.
+ * @param gen A random number generator (std::mt19937); two values are drawn from it to seed
+ *            the per-wolf streams used for initialization and the update process.
  * @param compute_a A function that computes the parameter `a` (which influences exploration 
  *                  and exploitation) based on the current iteration and total iterations. 
  *                  Default is the provided `compute_a` function.
@@ -91,49 +87,39 @@ std::pair<std::vector<double>, double> GreyWolfOptimizer(
     const std::vector<double>& lowerbound,
     const std::vector<double>& upperbound,
     int population, int iter, std::mt19937& gen, 
-    const std::function<double(int, int)>& compute_a = compute_a) 
+    const std::function<double(int, int)>& compute_a) 
 {
-    std::vector<Wolf> pack;
-    pack.reserve(population);
+    return GreyWolfOptimizer(function, lowerbound, upperbound, population, iter, draw_seed(gen), compute_a);
+}
 
-    // Initialize wolves randomly
-    for (int i = 0; i < population; ++i) {
-        pack.emplace_back(lowerbound, upperbound, gen);
+std::pair<std::vector<double>, double> GreyWolfOptimizer(
+    const std::function<double(const std::vector<double>&)>& function,
+    const std::vector<double>& lowerbound,
+    const std::vector<double>& upperbound,
+    int population, int iter, std::uint64_t seed,
+    const std::function<double(int, int)>& compute_a, GwoStats* stats,
+    const StoppingCriteria& criteria, Checkpointer* checkpointer,
+    const std::function<void(const IterationSample&)>& observer)
+{
+    if (observer) {
+        return GreyWolfOptimizerT(function, lowerbound, upperbound, population, iter, seed, compute_a, stats, criteria,
+                                  checkpointer, std::cref(observer));
     }
+    return GreyWolfOptimizerT(function, lowerbound, upperbound, population, iter, seed, compute_a, stats, criteria, checkpointer);
+}
 
-    // Track the best solution found
-    Wolf best_solution = pack[0];
-
-    for (int i = 0; i < iter; ++i) {
-        // Evaluate fitness
-        #pragma omp parallel for
-        for (int j = 0; j < population; ++j) {
-            pack[j].fitness = function(pack[j].position);
-
-            #pragma omp critical
-            if (pack[j].fitness < best_solution.fitness) {
-                best_solution = pack[j];
-            }
-        }
-
-        // Get the three best wolves (leaders)
-        std::partial_sort(pack.begin(), pack.begin() + 3, pack.end());
-        std::array<Wolf, 3> leaders = { pack[0], pack[1], pack[2] }; // Alpha, Beta and Delta Wolves
-
-        double a = compute_a(iter, i);
-
-        // Update positions
-        #pragma omp parllel for
-        for (Wolf& wolf : pack) {
-            for (size_t j = 0; j < lowerbound.size(); ++j) {
-                double X1 = update_position(wolf.position[j], leaders[0].position[j], a, gen); // Alpha's Influence on the wolf
-                double X2 = update_position(wolf.position[j], leaders[1].position[j], a, gen); // Beta's Influence on the wolf
-                double X3 = update_position(wolf.position[j], leaders[2].position[j], a, gen); // Delta's Influence on the wolf
-
-                wolf.position[j] = std::clamp((X1 + X2 + X3) / 3.0, lowerbound[j], upperbound[j]);
-            }
-        }
+std::pair<std::vector<double>, double> GreyWolfOptimizerBatch(
+    const BatchObjective& objective,
+    const std::vector<double>& lowerbound,
+    const std::vector<double>& upperbound,
+    int population, int iter, std::uint64_t seed,
+    const std::function<double(int, int)>& compute_a, GwoStats* stats,
+    const StoppingCriteria& criteria, Checkpointer* checkpointer,
+    const std::function<void(const IterationSample&)>& observer)
+{
+    if (observer) {
+        return GreyWolfOptimizerT(objective, lowerbound, upperbound, population, iter, seed, compute_a, stats, criteria,
+                                  checkpointer, std::cref(observer));
     }
-
-    return { best_solution.position, best_solution.fitness };
+    return GreyWolfOptimizerT(objective, lowerbound, upperbound, population, iter, seed, compute_a, stats, criteria, checkpointer);
 }
@@ -0,0 +1,297 @@
+#include <vector>
+#include <functional>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <exception>
+#include <stdexcept>
+#include <algorithm>
+#include <numeric>
+#include <limits>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "IslandGWO.hpp"
+#include "GWOCore.hpp"
+#include "Pack.hpp"
+#include "Random.hpp"
+#include "UpdateKernel.hpp"
+
+namespace {
+
+using gwo_detail::Clock;
+using gwo_detail::seconds_since;
+
+// Lock-free triple buffer carrying batches of migrants from one island to another.
+// The sender fills its own slot and swaps it with the middle one; the receiver swaps
+// its own slot with the middle one when a newer batch is there. Neither ever waits,
+// and the receiver always sees the latest complete batch.
+class Mailbox {
+public:
+    Mailbox(std::size_t migrants, std::size_t dimension) {
+        for (Pack& slot : slots_) {
+            slot.resize(migrants, dimension);
+        }
+    }
+
+    Mailbox(const Mailbox&) = delete;
+    Mailbox& operator=(const Mailbox&) = delete;
+
+    /// The slot the sender fills before calling `publish`. Sender only.
+    Pack& outgoing() { return slots_[back_]; }
+
+    /// Makes the filled slot the latest batch. Sender only.
+    void publish() {
+        back_ = state_.exchange(back_ | fresh, std::memory_order_acq_rel) & index_mask;
+    }
+
+    /// The latest batch if one arrived since the previous call, otherwise null. Receiver only.
+    const Pack* receive() {
+        if ((state_.load(std::memory_order_relaxed) & fresh) == 0) {
+            return nullptr;
+        }
+        front_ = state_.exchange(front_, std::memory_order_acq_rel) & index_mask;
+        return &slots_[front_];
+    }
+
+private:
+    static constexpr unsigned fresh = 4;       ///< Set while the middle slot has not been received.
+    static constexpr unsigned index_mask = 3;
+
+    Pack slots_[3];
+    unsigned back_ = 0;                        ///< Owned by the sender.
+    alignas(64) std::atomic<unsigned> state_{1};///< Index of the middle slot, with the `fresh` flag.
+    alignas(64) unsigned front_ = 2;           ///< Owned by the receiver.
+};
+
+// The state of one island, only touched by its thread until it is joined
+struct Island {
+    GwoWorkspace workspace;
+    std::vector<Mailbox*> outbox;  // One per outgoing edge
+    std::vector<Mailbox*> inbox;   // One per incoming edge
+    double best_fitness = std::numeric_limits<double>::max();
+    GwoStats stats;
+    long long migrants_sent = 0;
+    long long migrants_accepted = 0;
+    std::exception_ptr error;
+};
+
+// Destinations of the emigrants of `island`
+std::vector<std::size_t> neighbours(std::size_t island, std::size_t islands, IslandTopology topology) {
+    std::vector<std::size_t> targets;
+    if (islands < 2) return targets;
+
+    switch (topology) {
+        case IslandTopology::ring:
+            targets.push_back((island + 1) % islands);
+            break;
+        case IslandTopology::bidirectional_ring:
+            targets.push_back((island + 1) % islands);
+            if (islands > 2) targets.push_back((island + islands - 1) % islands);
+            break;
+        case IslandTopology::fully_connected:
+            for (std::size_t other = 0; other < islands; ++other) {
+                if (other != island) targets.push_back(other);
+            }
+            break;
+    }
+    return targets;
+}
+
+// Sends the best wolves of the pack along every outgoing edge, then lets the newest
+// immigrants of every incoming edge replace the worst wolves they beat.
+// `order` must hold the wolves sorted by increasing fitness.
+void migrate(Island& island, std::size_t migrants) {
+    Pack& pack = island.workspace.pack;
+    std::vector<int>& order = island.workspace.order;
+
+    for (Mailbox* mailbox : island.outbox) {
+        Pack& batch = mailbox->outgoing();
+        for (std::size_t k = 0; k < migrants; ++k) {
+            pack.copy_to(order[k], batch, k);
+        }
+        mailbox->publish();
+        island.migrants_sent += static_cast<long long>(migrants);
+    }
+
+    // The worst wolves are replaced from the back of the order, so an immigrant never
+    // overwrites one of this island's own emigrants or an earlier immigrant
+    std::size_t worst = order.size();
+    for (Mailbox* mailbox : island.inbox) {
+        const Pack* batch = mailbox->receive();
+        if (batch == nullptr) continue;
+        for (std::size_t k = 0; k < batch->population() && worst > migrants; ++k) {
+            int target = order[worst - 1];
+            if (batch->fitness(k) < pack.fitness(target)) {
+                batch->copy_to(k, pack, target);
+                --worst;
+                island.migrants_accepted += 1;
+            }
+        }
+    }
+
+    // Keep the order sorted for the leader selection that follows
+    std::sort(order.begin(), order.end(), [&pack](int lhs, int rhs) {
+        return pack.fitness(lhs) < pack.fitness(rhs) || (pack.fitness(lhs) == pack.fitness(rhs) && lhs < rhs);
+    });
+}
+
+} // namespace
+
+std::pair<std::vector<double>, double> GreyWolfOptimizerIslands(
+    const std::function<double(const std::vector<double>&)>& function,
+    const std::vector<double>& lowerbound,
+    const std::vector<double>& upperbound,
+    int population, int iter, std::uint64_t seed,
+    const IslandOptions& options,
+    const std::function<double(int, int)>& compute_a,
+    IslandStats* stats)
+{
+    if (population < 3) {
+        throw std::invalid_argument("Every island needs at least 3 wolves.");
+    }
+    if (options.migrants < 0 || options.migrants >= population) {
+        throw std::invalid_argument("The number of migrants must be between 0 and the island population.");
+    }
+    if (lowerbound.size() != upperbound.size()) {
+        throw std::invalid_argument("The lower and upper bounds must have the same size.");
+    }
+
+    const std::size_t dimension = lowerbound.size();
+    const std::size_t islands = options.islands == 0
+        ? std::max(1u, std::thread::hardware_concurrency()) : options.islands;
+    const std::size_t migrants = static_cast<std::size_t>(options.migrants);
+    const bool migrating = options.migration_interval > 0 && migrants > 0 && islands > 1;
+
+    std::vector<Island> pack_islands(islands);
+    std::vector<std::unique_ptr<Mailbox>> mailboxes;
+    if (migrating) {
+        for (std::size_t from = 0; from < islands; ++from) {
+            for (std::size_t to : neighbours(from, islands, options.topology)) {
+                mailboxes.push_back(std::make_unique<Mailbox>(migrants, dimension));
+                pack_islands[from].outbox.push_back(mailboxes.back().get());
+                pack_islands[to].inbox.push_back(mailboxes.back().get());
+            }
+        }
+    }
+
+    // Set by the first island whose objective throws, so the others stop early
+    std::atomic<bool> failed{false};
+
+    auto run_island = [&](std::size_t index) {
+#ifdef _OPENMP
+        omp_set_num_threads(1);  // The islands are the parallelism
+#endif
+        Island& island = pack_islands[index];
+        GwoWorkspace& workspace = island.workspace;
+        workspace.prepare(population, dimension, derive_seed(seed, index, 0));
+
+        Pack& pack = workspace.pack;
+        Pack& leaders = workspace.leaders;
+        std::vector<int>& order = workspace.order;
+        std::vector<VectorRng>& streams = workspace.streams;
+        std::vector<double>& scratch = workspace.scratch[0];
+        std::vector<double>& best_position = workspace.best_position;
+
+        try {
+            // Initialize wolves randomly
+            for (int w = 0; w < population; ++w) {
+                double* position = pack.position(w);
+                streams[w].fill_uniform(position, dimension);
+                for (std::size_t j = 0; j < dimension; ++j) {
+                    position[j] = lowerbound[j] + position[j] * (upperbound[j] - lowerbound[j]);
+                }
+            }
+            std::copy(pack.position(0), pack.position(0) + dimension, best_position.begin());
+
+            for (int i = 0; i < iter && !failed.load(std::memory_order_relaxed); ++i) {
+                // Evaluate fitness
+                auto evaluation_start = Clock::now();
+                gwo_detail::BestIndex iteration_best;
+                for (int w = 0; w < population; ++w) {
+                    std::copy(pack.position(w), pack.position(w) + dimension, scratch.begin());
+                    pack.fitness(w) = function(static_cast<const std::vector<double>&>(scratch));
+                    iteration_best = gwo_detail::better(iteration_best, gwo_detail::BestIndex{ pack.fitness(w), w });
+                }
+                island.stats.evaluations += population;
+                island.stats.evaluation_seconds += seconds_since(evaluation_start);
+                island.stats.iterations += 1;
+
+                if (iteration_best.fitness < island.best_fitness) {
+                    island.best_fitness = iteration_best.fitness;
+                    const double* position = pack.position(iteration_best.index);
+                    std::copy(position, position + dimension, best_position.begin());
+                }
+
+                // Get the three best wolves (leaders), after taking in immigrants on migration iterations
+                std::iota(order.begin(), order.end(), 0);
+                auto by_fitness = [&pack](int lhs, int rhs) {
+                    return pack.fitness(lhs) < pack.fitness(rhs)
+                        || (pack.fitness(lhs) == pack.fitness(rhs) && lhs < rhs);
+                };
+                if (migrating && (i + 1) % options.migration_interval == 0) {
+                    std::sort(order.begin(), order.end(), by_fitness);
+                    migrate(island, migrants);
+                    // An immigrant may beat everything this island has evaluated
+                    if (pack.fitness(order[0]) < island.best_fitness) {
+                        island.best_fitness = pack.fitness(order[0]);
+                        std::copy(pack.position(order[0]), pack.position(order[0]) + dimension, best_position.begin());
+                    }
+                } else {
+                    std::partial_sort(order.begin(), order.begin() + 3, order.end(), by_fitness);
+                }
+                for (int k = 0; k < 3; ++k) {
+                    pack.copy_to(order[k], leaders, k);
+                }
+
+                LeaderPositions leader_positions = { leaders.position(0), leaders.position(1), leaders.position(2) };
+                double a = compute_a(iter, i);
+
+                auto update_start = Clock::now();
+                for (int w = 0; w < population; ++w) {
+                    update_wolf(pack.position(w), leader_positions, lowerbound.data(), upperbound.data(), dimension, a, streams[w]);
+                }
+                island.stats.update_seconds += seconds_since(update_start);
+            }
+        } catch (...) {
+            island.error = std::current_exception();
+            failed.store(true, std::memory_order_relaxed);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(islands);
+    for (std::size_t index = 0; index < islands; ++index) {
+        threads.emplace_back(run_island, index);
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    IslandStats local_stats;
+    std::size_t best_island = 0;
+    for (std::size_t index = 0; index < islands; ++index) {
+        const Island& island = pack_islands[index];
+        if (island.error) {
+            std::rethrow_exception(island.error);
+        }
+        local_stats.totals.evaluations += island.stats.evaluations;
+        local_stats.totals.evaluation_seconds += island.stats.evaluation_seconds;
+        local_stats.totals.update_seconds += island.stats.update_seconds;
+        local_stats.totals.iterations = std::max(local_stats.totals.iterations, island.stats.iterations);
+        local_stats.best_fitness.push_back(island.best_fitness);
+        local_stats.migrants_sent += island.migrants_sent;
+        local_stats.migrants_accepted += island.migrants_accepted;
+        if (island.best_fitness < pack_islands[best_island].best_fitness) {
+            best_island = index;
+        }
+    }
+    if (stats != nullptr) {
+        *stats = std::move(local_stats);
+    }
+
+    const Island& winner = pack_islands[best_island];
+    return { winner.workspace.best_position, winner.best_fitness };
+}
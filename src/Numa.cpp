@@ -0,0 +1,209 @@
+#include <algorithm>
+#include <exception>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "Numa.hpp"
+
+namespace {
+
+#ifdef __linux__
+// The CPUs the process was allowed to run on before any pinning
+const cpu_set_t& process_cpus() {
+    static cpu_set_t allowed;
+    static std::once_flag once;
+    std::call_once(once, [] {
+        CPU_ZERO(&allowed);
+        if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+            for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) CPU_SET(cpu, &allowed);
+        }
+    });
+    return allowed;
+}
+
+// Parses a kernel CPU list such as "0-3,8-11"
+std::vector<int> parse_cpu_list(const std::string& text) {
+    std::vector<int> cpus;
+    std::stringstream list(text);
+    for (std::string range; std::getline(list, range, ',');) {
+        if (range.empty() || range == "\n") continue;
+        std::size_t dash = range.find('-');
+        int first = std::stoi(range.substr(0, dash));
+        int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+        for (int cpu = first; cpu <= last; ++cpu) cpus.push_back(cpu);
+    }
+    return cpus;
+}
+
+void set_affinity(const cpu_set_t& cpus) {
+    int error = pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+    if (error != 0) {
+        throw std::system_error(error, std::generic_category(), "Cannot set the CPU affinity of a thread");
+    }
+}
+
+int team_thread() {
+#ifdef _OPENMP
+    return omp_get_thread_num();
+#else
+    return 0;
+#endif
+}
+#endif
+
+} // namespace
+
+NumaTopology NumaTopology::detect() {
+#ifdef __linux__
+    const cpu_set_t& allowed = process_cpus();
+    NumaTopology topology;
+
+    for (int node = 0;; ++node) {
+        std::ifstream file("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+        if (!file) break;
+        std::string text;
+        std::getline(file, text);
+
+        std::vector<int> cpus;
+        for (int cpu : parse_cpu_list(text)) {
+            if (cpu < CPU_SETSIZE && CPU_ISSET(cpu, &allowed)) cpus.push_back(cpu);
+        }
+        // Nodes with memory only, or whose CPUs the process may not use, run no threads
+        if (!cpus.empty()) topology.node_cpus.push_back(cpus);
+    }
+
+    if (topology.node_cpus.empty()) {
+        std::vector<int> cpus;
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &allowed)) cpus.push_back(cpu);
+        }
+        topology.node_cpus.push_back(cpus);
+    }
+    return topology;
+#else
+    // No node or affinity information: every hardware thread on node 0
+    NumaTopology topology;
+    topology.node_cpus.emplace_back(std::max(1u, std::thread::hardware_concurrency()));
+    for (std::size_t cpu = 0; cpu < topology.node_cpus[0].size(); ++cpu) {
+        topology.node_cpus[0][cpu] = static_cast<int>(cpu);
+    }
+    return topology;
+#endif
+}
+
+std::size_t NumaTopology::cpus() const {
+    std::size_t count = 0;
+    for (const std::vector<int>& cpus : node_cpus) count += cpus.size();
+    return count;
+}
+
+NumaTopology NumaTopology::first_nodes(std::size_t count) const {
+    NumaTopology topology;
+    topology.node_cpus.assign(node_cpus.begin(), node_cpus.begin() + std::min(count, node_cpus.size()));
+    return topology;
+}
+
+ThreadPlacement pin_threads(const NumaTopology& topology, ThreadPinning pinning, int threads) {
+    if (topology.cpus() == 0) {
+        throw std::invalid_argument("The topology has no CPUs to run on.");
+    }
+#ifdef __linux__
+    const cpu_set_t& allowed = process_cpus();  // Read before any thread is pinned
+#endif
+    if (threads <= 0) {
+        threads = static_cast<int>(topology.cpus());
+    }
+
+    // The order in which threads take CPUs, with the node of each
+    std::vector<std::pair<int, int>> slots;
+    if (pinning == ThreadPinning::compact) {
+        for (std::size_t node = 0; node < topology.nodes(); ++node) {
+            for (int cpu : topology.node_cpus[node]) slots.push_back({ cpu, static_cast<int>(node) });
+        }
+    } else if (pinning == ThreadPinning::scatter) {
+        for (std::size_t index = 0; slots.size() < topology.cpus(); ++index) {
+            for (std::size_t node = 0; node < topology.nodes(); ++node) {
+                if (index < topology.node_cpus[node].size()) {
+                    slots.push_back({ topology.node_cpus[node][index], static_cast<int>(node) });
+                }
+            }
+        }
+    }
+
+    ThreadPlacement placement;
+    placement.cpus.assign(threads, -1);
+    placement.nodes.assign(threads, 0);
+    for (int t = 0; t < threads && !slots.empty(); ++t) {
+        placement.cpus[t] = slots[t % slots.size()].first;
+        placement.nodes[t] = slots[t % slots.size()].second;
+    }
+
+    // Number the nodes in use from 0, in the order of their first thread
+    std::vector<int> renumbered(topology.nodes(), -1);
+    placement.node_count = 0;
+    for (int t = 0; t < threads; ++t) {
+        int& node = renumbered[placement.nodes[t]];
+        if (node < 0) {
+            node = placement.node_count++;
+            placement.node_leaders.push_back(t);
+        }
+        placement.nodes[t] = node;
+    }
+
+#ifdef _OPENMP
+    omp_set_num_threads(threads);
+#endif
+#ifdef __linux__
+    std::exception_ptr failure;
+    #pragma omp parallel num_threads(threads)
+    {
+        const int t = team_thread();
+        try {
+            if (placement.cpus[t] >= 0) {
+                cpu_set_t cpu;
+                CPU_ZERO(&cpu);
+                CPU_SET(placement.cpus[t], &cpu);
+                set_affinity(cpu);
+            } else {
+                set_affinity(allowed);
+            }
+        } catch (...) {
+            #pragma omp critical(gwo_pin_threads)
+            failure = std::current_exception();
+        }
+    }
+    if (failure) {
+        std::rethrow_exception(failure);
+    }
+#else
+    // Without affinity masks the threads stay where the OS puts them
+    placement.cpus.assign(threads, -1);
+#endif
+    return placement;
+}
+
+void unpin_threads() {
+#ifdef __linux__
+    // Without OpenMP the calling thread is the whole team
+#ifdef _OPENMP
+    #pragma omp parallel num_threads(omp_get_max_threads())
+#endif
+    {
+        pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &process_cpus());
+    }
+#endif
+}
@@ -0,0 +1,255 @@
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <new>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+
+#include <linux/futex.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/prctl.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "ProcessEvaluator.hpp"
+
+namespace {
+
+static_assert(std::atomic<std::uint32_t>::is_always_lock_free && std::atomic<std::uint64_t>::is_always_lock_free,
+              "The shared counters must be address-free to work across processes");
+
+// How long the parent sleeps between two checks for crashed workers
+constexpr long crash_check_nanoseconds = 50 * 1000 * 1000;
+
+constexpr std::int32_t no_point = -1;
+
+// The futexes live in memory shared between processes, so the private variants cannot be used
+void futex_wait(std::atomic<std::uint32_t>& word, std::uint32_t expected, const timespec* timeout) {
+    syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), FUTEX_WAIT, expected, timeout, nullptr, 0);
+}
+
+void futex_wake_all(std::atomic<std::uint32_t>& word) {
+    syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+}
+
+std::size_t round_up(std::size_t bytes) {
+    return (bytes + 63) / 64 * 64;
+}
+
+} // namespace
+
+// Header of the shared segment; the worker slots and the arrays follow it
+struct ProcessEvaluator::Segment {
+    alignas(64) std::atomic<std::uint32_t> generation;  ///< Bumped for every call; the workers' futex.
+    std::atomic<std::uint32_t> shutdown;
+    std::atomic<std::uint32_t> count;                   ///< Points in the current call.
+    alignas(64) std::atomic<std::uint64_t> ticket;      ///< Generation in the high half, next point to claim in the low half.
+    alignas(64) std::atomic<std::uint32_t> remaining;   ///< Points not finished; the parent's futex.
+
+    std::size_t workers;
+    std::size_t slots_offset;
+    std::size_t fitness_offset;
+    std::size_t failed_offset;
+    std::size_t positions_offset;
+
+    // The point each worker is evaluating, or `no_point`, one cache line per worker
+    std::atomic<std::int32_t>& claimed(std::size_t worker) {
+        return *reinterpret_cast<std::atomic<std::int32_t>*>(reinterpret_cast<char*>(this) + slots_offset + worker * 64);
+    }
+    double* fitness() { return reinterpret_cast<double*>(reinterpret_cast<char*>(this) + fitness_offset); }
+    std::uint8_t* failed() { return reinterpret_cast<std::uint8_t*>(this) + failed_offset; }
+    double* positions() { return reinterpret_cast<double*>(reinterpret_cast<char*>(this) + positions_offset); }
+};
+
+ProcessEvaluator::ProcessEvaluator(std::function<double(const std::vector<double>&)> function,
+                                   std::size_t dimension, std::size_t max_population, std::size_t workers,
+                                   double failure_fitness)
+    : function_(std::move(function)), dimension_(dimension), max_population_(max_population),
+      failure_fitness_(failure_fitness) {
+    if (workers == 0) {
+        workers = std::max(1u, std::thread::hardware_concurrency());
+    }
+    if (max_population > static_cast<std::size_t>(INT32_MAX)) {
+        throw std::invalid_argument("The population of a ProcessEvaluator must fit in 32 bits.");
+    }
+
+    const std::size_t slots_offset = round_up(sizeof(Segment));
+    const std::size_t fitness_offset = slots_offset + workers * 64;
+    const std::size_t failed_offset = round_up(fitness_offset + max_population * sizeof(double));
+    const std::size_t positions_offset = round_up(failed_offset + max_population);
+    segment_bytes_ = positions_offset + max_population * dimension * sizeof(double);
+
+    // Anonymous and shared, so it is inherited by every fork and needs no name or file
+    void* memory = mmap(nullptr, segment_bytes_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED) {
+        throw std::system_error(errno, std::generic_category(), "ProcessEvaluator: mmap");
+    }
+    segment_ = new (memory) Segment();
+    segment_->generation.store(0, std::memory_order_relaxed);
+    segment_->shutdown.store(0, std::memory_order_relaxed);
+    segment_->count.store(0, std::memory_order_relaxed);
+    segment_->ticket.store(0, std::memory_order_relaxed);
+    segment_->remaining.store(0, std::memory_order_relaxed);
+    segment_->workers = workers;
+    segment_->slots_offset = slots_offset;
+    segment_->fitness_offset = fitness_offset;
+    segment_->failed_offset = failed_offset;
+    segment_->positions_offset = positions_offset;
+    for (std::size_t worker = 0; worker < workers; ++worker) {
+        new (&segment_->claimed(worker)) std::atomic<std::int32_t>(no_point);
+    }
+
+    pids_.assign(workers, -1);
+    try {
+        for (std::size_t worker = 0; worker < workers; ++worker) {
+            spawn(worker);
+        }
+    } catch (...) {
+        stop();
+        throw;
+    }
+}
+
+ProcessEvaluator::~ProcessEvaluator() {
+    stop();
+}
+
+void ProcessEvaluator::stop() {
+    if (segment_ == nullptr) return;
+
+    segment_->shutdown.store(1, std::memory_order_relaxed);
+    segment_->generation.fetch_add(1, std::memory_order_release);
+    futex_wake_all(segment_->generation);
+    for (pid_t pid : pids_) {
+        if (pid > 0) {
+            waitpid(pid, nullptr, 0);
+        }
+    }
+
+    munmap(segment_, segment_bytes_);
+    segment_ = nullptr;
+}
+
+// Forks the worker of index `worker`. It starts with the current generation, so a
+// replacement forked in the middle of a call joins it.
+void ProcessEvaluator::spawn(std::size_t worker) const {
+    const pid_t parent = getpid();
+    const std::uint32_t seen = segment_->generation.load(std::memory_order_acquire) - 1;
+
+    pid_t pid = fork();
+    if (pid < 0) {
+        throw std::system_error(errno, std::generic_category(), "ProcessEvaluator: fork");
+    }
+    if (pid > 0) {
+        pids_[worker] = pid;
+        return;
+    }
+
+    // Worker process: never returns into the parent's code, and never runs its destructors
+    prctl(PR_SET_PDEATHSIG, SIGKILL);
+    if (getppid() != parent) _exit(0);
+
+    Segment& segment = *segment_;
+    std::atomic<std::int32_t>& claimed = segment.claimed(worker);
+    std::vector<double> point(dimension_);
+    std::uint32_t generation = seen;
+
+    for (;;) {
+        std::uint32_t current;
+        while ((current = segment.generation.load(std::memory_order_acquire)) == generation) {
+            futex_wait(segment.generation, generation, nullptr);
+        }
+        generation = current;
+        if (segment.shutdown.load(std::memory_order_relaxed) != 0) {
+            _exit(0);
+        }
+
+        // A claim only succeeds while the ticket is still of this generation, so a worker
+        // late out of one call can never take a point of the next one. The count is
+        // published after the ticket, so a new count always comes with a new ticket.
+        const std::uint32_t count = segment.count.load(std::memory_order_acquire);
+        std::uint64_t ticket = segment.ticket.load(std::memory_order_relaxed);
+        for (;;) {
+            const auto index = static_cast<std::uint32_t>(ticket);
+            if (ticket >> 32 != generation || index >= count) break;
+            if (!segment.ticket.compare_exchange_weak(ticket, ticket + 1, std::memory_order_relaxed)) continue;
+            claimed.store(static_cast<std::int32_t>(index), std::memory_order_relaxed);
+
+            const double* position = segment.positions() + index * dimension_;
+            std::copy(position, position + dimension_, point.begin());
+            double fitness;
+            try {
+                fitness = function_(point);
+            } catch (...) {
+                fitness = failure_fitness_;
+                segment.failed()[index] = 1;
+            }
+            segment.fitness()[index] = fitness;
+
+            claimed.store(no_point, std::memory_order_relaxed);
+            if (segment.remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                futex_wake_all(segment.remaining);
+            }
+            ticket = segment.ticket.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+// Reaps the workers that died, fails the point each one was evaluating and forks replacements
+void ProcessEvaluator::reap_crashed() const {
+    for (std::size_t worker = 0; worker < pids_.size(); ++worker) {
+        if (waitpid(pids_[worker], nullptr, WNOHANG) != pids_[worker]) continue;
+
+        std::int32_t index = segment_->claimed(worker).exchange(no_point, std::memory_order_relaxed);
+        if (index != no_point) {
+            segment_->fitness()[index] = failure_fitness_;
+            segment_->failed()[index] = 1;
+            segment_->remaining.fetch_sub(1, std::memory_order_acq_rel);
+        }
+        pids_[worker] = -1;
+        stats_.restarts += 1;
+        spawn(worker);
+    }
+}
+
+void ProcessEvaluator::operator()(const PopulationView& positions, Span<double> fitness) const {
+    if (positions.dimension != dimension_ || positions.population > max_population_) {
+        throw std::invalid_argument("ProcessEvaluator: the pack is larger than the evaluator was created for.");
+    }
+    const std::size_t count = positions.population;
+    if (count == 0) return;
+
+    Segment& segment = *segment_;
+    for (std::size_t i = 0; i < count; ++i) {
+        Span<const double> row = positions.row(i);
+        std::copy(row.begin(), row.end(), segment.positions() + i * dimension_);
+    }
+    std::memset(segment.failed(), 0, count);
+
+    // Publish the call: the release on `generation` makes everything above visible to the workers
+    const std::uint32_t generation = segment.generation.load(std::memory_order_relaxed) + 1;
+    segment.ticket.store(static_cast<std::uint64_t>(generation) << 32, std::memory_order_relaxed);
+    segment.count.store(static_cast<std::uint32_t>(count), std::memory_order_release);
+    segment.remaining.store(static_cast<std::uint32_t>(count), std::memory_order_relaxed);
+    segment.generation.store(generation, std::memory_order_release);
+    futex_wake_all(segment.generation);
+
+    const timespec timeout = { 0, crash_check_nanoseconds };
+    for (;;) {
+        std::uint32_t remaining = segment.remaining.load(std::memory_order_acquire);
+        if (remaining == 0) break;
+        futex_wait(segment.remaining, remaining, &timeout);
+        reap_crashed();
+    }
+
+    std::copy(segment.fitness(), segment.fitness() + count, fitness.begin());
+    stats_.evaluations += static_cast<long long>(count);
+    stats_.failures += std::count(segment.failed(), segment.failed() + count, std::uint8_t(1));
+}
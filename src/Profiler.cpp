@@ -0,0 +1,300 @@
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <map>
+#include <utility>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "Profiler.hpp"
+
+namespace {
+
+constexpr std::size_t phase_count = static_cast<std::size_t>(ProfilePhase::count);
+constexpr std::size_t counter_count = static_cast<std::size_t>(ProfileCounter::count);
+
+bool is_team_phase(ProfilePhase phase) {
+    return phase == ProfilePhase::evaluation_thread || phase == ProfilePhase::update_thread;
+}
+
+#ifdef __linux__
+int open_counter(std::uint64_t config, int group) {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = config;
+    attr.read_format = PERF_FORMAT_GROUP;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, group, 0));
+}
+
+// A group of the cycle and instruction counters of the calling thread, or -1. The
+// instruction counter stays open as long as the group, for the life of the process.
+int open_counter_group() {
+    int cycles = open_counter(PERF_COUNT_HW_CPU_CYCLES, -1);
+    if (cycles < 0) return -1;
+    if (open_counter(PERF_COUNT_HW_INSTRUCTIONS, cycles) < 0) {
+        close(cycles);
+        return -1;
+    }
+    return cycles;
+}
+#else
+int open_counter_group() { return -1; }
+#endif
+
+} // namespace
+
+const char* to_string(ProfilePhase phase) {
+    switch (phase) {
+    case ProfilePhase::none: return "none";
+    case ProfilePhase::initialization: return "initialization";
+    case ProfilePhase::evaluation: return "evaluation";
+    case ProfilePhase::evaluation_thread: return "evaluation_thread";
+    case ProfilePhase::best_update: return "best_update";
+    case ProfilePhase::stopping: return "stopping";
+    case ProfilePhase::leader_selection: return "leader_selection";
+    case ProfilePhase::leader_copy: return "leader_copy";
+    case ProfilePhase::update: return "update";
+    case ProfilePhase::update_thread: return "update_thread";
+    case ProfilePhase::observer: return "observer";
+    case ProfilePhase::checkpoint: return "checkpoint";
+    case ProfilePhase::count: break;
+    }
+    return "unknown";
+}
+
+const char* to_string(ProfileCounter counter) {
+    switch (counter) {
+    case ProfileCounter::evaluations: return "evaluations";
+    case ProfileCounter::iterations: return "iterations";
+    case ProfileCounter::improvements: return "improvements";
+    case ProfileCounter::count: break;
+    }
+    return "unknown";
+}
+
+void ProfileThread::read_hardware(std::uint64_t& cycles, std::uint64_t& instructions) {
+    if (!perf_opened) {
+        perf_opened = true;
+        perf_fd = open_counter_group();
+    }
+    cycles = 0;
+    instructions = 0;
+#ifdef __linux__
+    if (perf_fd < 0) return;
+    std::uint64_t values[3] = {};  // The number of counters, then their values
+    if (read(perf_fd, values, sizeof(values)) == static_cast<ssize_t>(sizeof(values))) {
+        cycles = values[1];
+        instructions = values[2];
+    }
+#endif
+}
+
+Profiler::Profiler() : epoch_ticks_(profile_ticks()), epoch_time_(std::chrono::steady_clock::now()) {}
+
+Profiler& Profiler::instance() {
+    static Profiler profiler;
+    return profiler;
+}
+
+ProfileThread* Profiler::register_thread() {
+    auto record = std::make_unique<ProfileThread>();
+    record->events.reserve(events_per_thread);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    record->id = static_cast<int>(threads_.size());
+    threads_.push_back(std::move(record));
+    return threads_.back().get();
+}
+
+bool Profiler::enable_hardware_counters() {
+    int probe = open_counter_group();
+    if (probe < 0) return false;
+#ifdef __linux__
+    close(probe);
+#endif
+    hardware_.store(true, std::memory_order_relaxed);
+    return true;
+}
+
+void Profiler::reset() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const std::unique_ptr<ProfileThread>& thread : threads_) {
+        thread->events.clear();
+        thread->dropped = 0;
+        thread->totals = {};
+        thread->counters = {};
+        thread->current = ProfilePhase::none;
+    }
+}
+
+ProfilePhaseTotals Profiler::totals(ProfilePhase phase) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ProfilePhaseTotals sum;
+    for (const std::unique_ptr<ProfileThread>& thread : threads_) {
+        const ProfilePhaseTotals& total = thread->totals[static_cast<std::size_t>(phase)];
+        sum.calls += total.calls;
+        sum.ticks += total.ticks;
+        sum.cycles += total.cycles;
+        sum.instructions += total.instructions;
+    }
+    return sum;
+}
+
+long long Profiler::counter(ProfileCounter counter) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    long long sum = 0;
+    for (const std::unique_ptr<ProfileThread>& thread : threads_) {
+        sum += thread->counters[static_cast<std::size_t>(counter)];
+    }
+    return sum;
+}
+
+long long Profiler::dropped_events() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    long long sum = 0;
+    for (const std::unique_ptr<ProfileThread>& thread : threads_) {
+        sum += thread->dropped;
+    }
+    return sum;
+}
+
+double Profiler::nanoseconds_per_tick() const {
+    std::uint64_t ticks = profile_ticks() - epoch_ticks_;
+    double nanoseconds = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - epoch_time_).count();
+    return ticks > 0 ? nanoseconds / ticks : 1.0;
+}
+
+void Profiler::write_chrome_trace(std::ostream& out) const {
+    const double microseconds_per_tick = nanoseconds_per_tick() / 1000.0;
+    const bool hardware = hardware_counters();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    bool first = true;
+    auto separate = [&] {
+        if (!first) out << ",\n";
+        first = false;
+    };
+
+    out << std::fixed << std::setprecision(3);
+    for (const std::unique_ptr<ProfileThread>& thread : threads_) {
+        separate();
+        out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << thread->id
+            << ",\"args\":{\"name\":\"thread " << thread->id << "\"}}";
+        for (const ProfileEvent& event : thread->events) {
+            separate();
+            out << "{\"name\":\"" << to_string(event.phase) << "\",\"cat\":\"gwo\",\"ph\":\"X\",\"pid\":1,\"tid\":"
+                << thread->id << ",\"ts\":" << (event.start - epoch_ticks_) * microseconds_per_tick
+                << ",\"dur\":" << event.duration * microseconds_per_tick;
+            if (hardware || event.parent_thread >= 0) {
+                out << ",\"args\":{";
+                if (hardware) {
+                    out << "\"cycles\":" << event.cycles << ",\"instructions\":" << event.instructions;
+                }
+                if (event.parent_thread >= 0) {
+                    out << (hardware ? "," : "") << "\"team\":" << event.parent_thread;
+                }
+                out << "}";
+            }
+            out << "}";
+        }
+    }
+    out << "]}\n";
+}
+
+void Profiler::write_summary(std::ostream& out) const {
+    const double milliseconds_per_tick = nanoseconds_per_tick() / 1e6;
+    const bool hardware = hardware_counters();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    std::array<ProfilePhaseTotals, phase_count> totals{};
+    std::array<long long, counter_count> counters{};
+    std::uint64_t wall_ticks = 0;  // Of the phases on the optimizer's thread
+    for (const std::unique_ptr<ProfileThread>& thread : threads_) {
+        for (std::size_t p = 0; p < phase_count; ++p) {
+            totals[p].calls += thread->totals[p].calls;
+            totals[p].ticks += thread->totals[p].ticks;
+            totals[p].cycles += thread->totals[p].cycles;
+            totals[p].instructions += thread->totals[p].instructions;
+            if (!is_team_phase(static_cast<ProfilePhase>(p))) wall_ticks += thread->totals[p].ticks;
+        }
+        for (std::size_t c = 0; c < counter_count; ++c) {
+            counters[c] += thread->counters[c];
+        }
+    }
+
+    const std::ios_base::fmtflags flags = out.flags();
+    const std::streamsize precision = out.precision();
+    out << std::fixed << std::setprecision(3);
+
+    out << std::left << std::setw(18) << "phase" << std::right << std::setw(10) << "calls"
+        << std::setw(14) << "total ms" << std::setw(12) << "mean us" << std::setw(9) << "share";
+    if (hardware) out << std::setw(16) << "cycles" << std::setw(16) << "instructions" << std::setw(7) << "IPC";
+    out << '\n';
+    for (std::size_t p = 1; p < phase_count; ++p) {
+        const ProfilePhaseTotals& total = totals[p];
+        if (total.calls == 0) continue;
+        const ProfilePhase phase = static_cast<ProfilePhase>(p);
+        double milliseconds = total.ticks * milliseconds_per_tick;
+        out << std::left << std::setw(18) << to_string(phase) << std::right << std::setw(10) << total.calls
+            << std::setw(14) << milliseconds << std::setw(12) << 1000.0 * milliseconds / total.calls;
+        // The busy time of the threads overlaps the wall time of their phase
+        if (is_team_phase(phase) || wall_ticks == 0) {
+            out << std::setw(9) << "-";
+        } else {
+            out << std::setw(8) << 100.0 * total.ticks / wall_ticks << '%';
+        }
+        if (hardware) {
+            out << std::setw(16) << total.cycles << std::setw(16) << total.instructions << std::setw(7)
+                << (total.cycles > 0 ? static_cast<double>(total.instructions) / total.cycles : 0.0);
+        }
+        out << '\n';
+    }
+
+    out << "counters:";
+    for (std::size_t c = 0; c < counter_count; ++c) {
+        out << ' ' << to_string(static_cast<ProfileCounter>(c)) << '=' << counters[c];
+    }
+    out << '\n';
+
+    // Idle time of a thread in a parallel phase: the wall time of the master's phase minus
+    // the thread's busy time, for the events still in the trace
+    std::map<std::pair<int, std::uint64_t>, std::uint64_t> phase_ends;
+    for (const std::unique_ptr<ProfileThread>& thread : threads_) {
+        for (const ProfileEvent& event : thread->events) {
+            if (event.phase == ProfilePhase::evaluation || event.phase == ProfilePhase::update) {
+                phase_ends[{ thread->id, event.start }] = event.start + event.duration;
+            }
+        }
+    }
+
+    out << std::left << std::setw(18) << "thread" << std::right << std::setw(14) << "busy ms"
+        << std::setw(14) << "idle ms" << std::setw(10) << "dropped" << '\n';
+    for (const std::unique_ptr<ProfileThread>& thread : threads_) {
+        std::uint64_t busy = thread->totals[static_cast<std::size_t>(ProfilePhase::evaluation_thread)].ticks
+                           + thread->totals[static_cast<std::size_t>(ProfilePhase::update_thread)].ticks;
+        std::uint64_t idle = 0;
+        for (const ProfileEvent& event : thread->events) {
+            if (!is_team_phase(event.phase)) continue;
+            auto end = phase_ends.find({ event.parent_thread, event.parent_start });
+            if (end == phase_ends.end()) continue;
+            std::uint64_t span = end->second - event.parent_start;
+            idle += span > event.duration ? span - event.duration : 0;
+        }
+        if (busy == 0 && thread->dropped == 0) continue;
+        out << std::left << std::setw(18) << thread->id << std::right << std::setw(14) << busy * milliseconds_per_tick
+            << std::setw(14) << idle * milliseconds_per_tick << std::setw(10) << thread->dropped << '\n';
+    }
+
+    out.flags(flags);
+    out.precision(precision);
+}
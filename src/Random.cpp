@@ -0,0 +1,380 @@
+#include <cstring>
+
+#include "Random.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define GWO_HAVE_X86_SIMD 1
+#endif
+
+#if defined(__GNUC__) && !defined(__clang__)
+// GCC 12 warns about the _mm512_undefined_* placeholders inside its own AVX-512 intrinsics
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+namespace {
+
+constexpr std::uint64_t exponent_one = 0x3FF0000000000000ULL;
+
+inline std::uint64_t rotl(std::uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+// One xoshiro256+ step of all lanes, writing `VectorRng::lanes` doubles in [0, 1)
+inline void step_scalar(std::uint64_t (&s)[4][VectorRng::lanes], double* out) {
+    for (std::size_t lane = 0; lane < VectorRng::lanes; ++lane) {
+        std::uint64_t result = s[0][lane] + s[3][lane];
+        std::uint64_t t = s[1][lane] << 17;
+
+        s[2][lane] ^= s[0][lane];
+        s[3][lane] ^= s[1][lane];
+        s[1][lane] ^= s[2][lane];
+        s[0][lane] ^= s[3][lane];
+        s[2][lane] ^= t;
+        s[3][lane] = rotl(s[3][lane], 45);
+
+        // Place the top 52 bits in the mantissa of a double in [1, 2) and shift down
+        std::uint64_t bits = (result >> 12) | exponent_one;
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        out[lane] = value - 1.0;
+    }
+}
+
+void fill_scalar(std::uint64_t (&state)[4][VectorRng::lanes], double* out, std::size_t n) {
+    // Work on a local copy so the state stays in registers instead of being
+    // reloaded after every store to `out`
+    std::uint64_t s[4][VectorRng::lanes];
+    std::memcpy(s, state, sizeof(s));
+
+    std::size_t i = 0;
+    for (; i + VectorRng::lanes <= n; i += VectorRng::lanes) {
+        step_scalar(s, out + i);
+    }
+    if (i < n) {
+        double tail[VectorRng::lanes];
+        step_scalar(s, tail);
+        std::memcpy(out + i, tail, (n - i) * sizeof(double));
+    }
+
+    std::memcpy(state, s, sizeof(s));
+}
+
+constexpr std::uint32_t float_exponent_one = 0x3F800000U;
+constexpr std::uint64_t float_mantissa_mask = 0x7FFFFFU;
+
+// Bits [1, 2) of a float with the 23-bit mantissa `mantissa`, shifted down to [0, 1)
+inline float unit_float(std::uint64_t mantissa) {
+    std::uint32_t bits = static_cast<std::uint32_t>(mantissa) | float_exponent_one;
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value - 1.0f;
+}
+
+// One xoshiro256+ step of all lanes, writing `2 * VectorRng::lanes` floats in [0, 1):
+// first one from bits 41-63 of every lane, then one from bits 18-40. The lowest bits
+// of xoshiro256+ are weak and are never used.
+inline void step_scalar_float(std::uint64_t (&s)[4][VectorRng::lanes], float* out) {
+    for (std::size_t lane = 0; lane < VectorRng::lanes; ++lane) {
+        std::uint64_t result = s[0][lane] + s[3][lane];
+        std::uint64_t t = s[1][lane] << 17;
+
+        s[2][lane] ^= s[0][lane];
+        s[3][lane] ^= s[1][lane];
+        s[1][lane] ^= s[2][lane];
+        s[0][lane] ^= s[3][lane];
+        s[2][lane] ^= t;
+        s[3][lane] = rotl(s[3][lane], 45);
+
+        out[lane] = unit_float(result >> 41);
+        out[VectorRng::lanes + lane] = unit_float((result >> 18) & float_mantissa_mask);
+    }
+}
+
+void fill_scalar(std::uint64_t (&state)[4][VectorRng::lanes], float* out, std::size_t n) {
+    constexpr std::size_t per_step = 2 * VectorRng::lanes;
+    std::uint64_t s[4][VectorRng::lanes];
+    std::memcpy(s, state, sizeof(s));
+
+    std::size_t i = 0;
+    for (; i + per_step <= n; i += per_step) {
+        step_scalar_float(s, out + i);
+    }
+    if (i < n) {
+        float tail[per_step];
+        step_scalar_float(s, tail);
+        std::memcpy(out + i, tail, (n - i) * sizeof(float));
+    }
+
+    std::memcpy(state, s, sizeof(s));
+}
+
+#ifdef GWO_HAVE_X86_SIMD
+
+__attribute__((target("avx2")))
+inline __m256i rotl_avx2(__m256i x, int k) {
+    return _mm256_or_si256(_mm256_slli_epi64(x, k), _mm256_srli_epi64(x, 64 - k));
+}
+
+// The eight lanes are processed as two independent halves of four
+__attribute__((target("avx2")))
+void fill_avx2(std::uint64_t (&s)[4][VectorRng::lanes], double* out, std::size_t n) {
+    const __m256i one = _mm256_set1_epi64x(static_cast<long long>(exponent_one));
+    const __m256d one_d = _mm256_set1_pd(1.0);
+
+    __m256i s0[2], s1[2], s2[2], s3[2];
+    for (int h = 0; h < 2; ++h) {
+        s0[h] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&s[0][4 * h]));
+        s1[h] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&s[1][4 * h]));
+        s2[h] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&s[2][4 * h]));
+        s3[h] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&s[3][4 * h]));
+    }
+
+    std::size_t i = 0;
+    for (; i + VectorRng::lanes <= n; i += VectorRng::lanes) {
+        for (int h = 0; h < 2; ++h) {
+            __m256i result = _mm256_add_epi64(s0[h], s3[h]);
+            __m256i t = _mm256_slli_epi64(s1[h], 17);
+
+            s2[h] = _mm256_xor_si256(s2[h], s0[h]);
+            s3[h] = _mm256_xor_si256(s3[h], s1[h]);
+            s1[h] = _mm256_xor_si256(s1[h], s2[h]);
+            s0[h] = _mm256_xor_si256(s0[h], s3[h]);
+            s2[h] = _mm256_xor_si256(s2[h], t);
+            s3[h] = rotl_avx2(s3[h], 45);
+
+            __m256i bits = _mm256_or_si256(_mm256_srli_epi64(result, 12), one);
+            _mm256_storeu_pd(out + i + 4 * h, _mm256_sub_pd(_mm256_castsi256_pd(bits), one_d));
+        }
+    }
+
+    for (int h = 0; h < 2; ++h) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(&s[0][4 * h]), s0[h]);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(&s[1][4 * h]), s1[h]);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(&s[2][4 * h]), s2[h]);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(&s[3][4 * h]), s3[h]);
+    }
+
+    if (i < n) {
+        fill_scalar(s, out + i, n - i);
+    }
+}
+
+__attribute__((target("avx512f")))
+void fill_avx512(std::uint64_t (&s)[4][VectorRng::lanes], double* out, std::size_t n) {
+    const __m512i one = _mm512_set1_epi64(static_cast<long long>(exponent_one));
+    const __m512d one_d = _mm512_set1_pd(1.0);
+
+    __m512i s0 = _mm512_loadu_si512(&s[0][0]);
+    __m512i s1 = _mm512_loadu_si512(&s[1][0]);
+    __m512i s2 = _mm512_loadu_si512(&s[2][0]);
+    __m512i s3 = _mm512_loadu_si512(&s[3][0]);
+
+    std::size_t i = 0;
+    for (; i + VectorRng::lanes <= n; i += VectorRng::lanes) {
+        __m512i result = _mm512_add_epi64(s0, s3);
+        __m512i t = _mm512_slli_epi64(s1, 17);
+
+        s2 = _mm512_xor_si512(s2, s0);
+        s3 = _mm512_xor_si512(s3, s1);
+        s1 = _mm512_xor_si512(s1, s2);
+        s0 = _mm512_xor_si512(s0, s3);
+        s2 = _mm512_xor_si512(s2, t);
+        s3 = _mm512_rol_epi64(s3, 45);
+
+        __m512i bits = _mm512_or_si512(_mm512_srli_epi64(result, 12), one);
+        _mm512_storeu_pd(out + i, _mm512_sub_pd(_mm512_castsi512_pd(bits), one_d));
+    }
+
+    _mm512_storeu_si512(&s[0][0], s0);
+    _mm512_storeu_si512(&s[1][0], s1);
+    _mm512_storeu_si512(&s[2][0], s2);
+    _mm512_storeu_si512(&s[3][0], s3);
+
+    if (i < n) {
+        fill_scalar(s, out + i, n - i);
+    }
+}
+
+// The float version of fill_avx2: the two floats of every lane are packed into one
+// 64-bit element, then deinterleaved so each half of the step is stored contiguously
+__attribute__((target("avx2")))
+void fill_avx2(std::uint64_t (&s)[4][VectorRng::lanes], float* out, std::size_t n) {
+    constexpr std::size_t per_step = 2 * VectorRng::lanes;
+    const __m256i mask = _mm256_set1_epi64x(static_cast<long long>(float_mantissa_mask));
+    const __m256i one = _mm256_set1_epi32(static_cast<int>(float_exponent_one));
+    const __m256i deinterleave = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+    const __m256 one_f = _mm256_set1_ps(1.0f);
+
+    __m256i s0[2], s1[2], s2[2], s3[2];
+    for (int h = 0; h < 2; ++h) {
+        s0[h] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&s[0][4 * h]));
+        s1[h] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&s[1][4 * h]));
+        s2[h] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&s[2][4 * h]));
+        s3[h] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&s[3][4 * h]));
+    }
+
+    std::size_t i = 0;
+    for (; i + per_step <= n; i += per_step) {
+        for (int h = 0; h < 2; ++h) {
+            __m256i result = _mm256_add_epi64(s0[h], s3[h]);
+            __m256i t = _mm256_slli_epi64(s1[h], 17);
+
+            s2[h] = _mm256_xor_si256(s2[h], s0[h]);
+            s3[h] = _mm256_xor_si256(s3[h], s1[h]);
+            s1[h] = _mm256_xor_si256(s1[h], s2[h]);
+            s0[h] = _mm256_xor_si256(s0[h], s3[h]);
+            s2[h] = _mm256_xor_si256(s2[h], t);
+            s3[h] = rotl_avx2(s3[h], 45);
+
+            __m256i high = _mm256_srli_epi64(result, 41);
+            __m256i low = _mm256_and_si256(_mm256_srli_epi64(result, 18), mask);
+            __m256i packed = _mm256_permutevar8x32_epi32(_mm256_or_si256(high, _mm256_slli_epi64(low, 32)), deinterleave);
+            __m256 values = _mm256_sub_ps(_mm256_castsi256_ps(_mm256_or_si256(packed, one)), one_f);
+            _mm_storeu_ps(out + i + 4 * h, _mm256_castps256_ps128(values));
+            _mm_storeu_ps(out + i + VectorRng::lanes + 4 * h, _mm256_extractf128_ps(values, 1));
+        }
+    }
+
+    for (int h = 0; h < 2; ++h) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(&s[0][4 * h]), s0[h]);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(&s[1][4 * h]), s1[h]);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(&s[2][4 * h]), s2[h]);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(&s[3][4 * h]), s3[h]);
+    }
+
+    if (i < n) {
+        fill_scalar(s, out + i, n - i);
+    }
+}
+
+__attribute__((target("avx512f")))
+void fill_avx512(std::uint64_t (&s)[4][VectorRng::lanes], float* out, std::size_t n) {
+    constexpr std::size_t per_step = 2 * VectorRng::lanes;
+    const __m512i mask = _mm512_set1_epi64(static_cast<long long>(float_mantissa_mask));
+    const __m256i one = _mm256_set1_epi32(static_cast<int>(float_exponent_one));
+    const __m256 one_f = _mm256_set1_ps(1.0f);
+
+    __m512i s0 = _mm512_loadu_si512(&s[0][0]);
+    __m512i s1 = _mm512_loadu_si512(&s[1][0]);
+    __m512i s2 = _mm512_loadu_si512(&s[2][0]);
+    __m512i s3 = _mm512_loadu_si512(&s[3][0]);
+
+    std::size_t i = 0;
+    for (; i + per_step <= n; i += per_step) {
+        __m512i result = _mm512_add_epi64(s0, s3);
+        __m512i t = _mm512_slli_epi64(s1, 17);
+
+        s2 = _mm512_xor_si512(s2, s0);
+        s3 = _mm512_xor_si512(s3, s1);
+        s1 = _mm512_xor_si512(s1, s2);
+        s0 = _mm512_xor_si512(s0, s3);
+        s2 = _mm512_xor_si512(s2, t);
+        s3 = _mm512_rol_epi64(s3, 45);
+
+        __m256i high = _mm512_cvtepi64_epi32(_mm512_srli_epi64(result, 41));
+        __m256i low = _mm512_cvtepi64_epi32(_mm512_and_si512(_mm512_srli_epi64(result, 18), mask));
+        _mm256_storeu_ps(out + i, _mm256_sub_ps(_mm256_castsi256_ps(_mm256_or_si256(high, one)), one_f));
+        _mm256_storeu_ps(out + i + VectorRng::lanes, _mm256_sub_ps(_mm256_castsi256_ps(_mm256_or_si256(low, one)), one_f));
+    }
+
+    _mm512_storeu_si512(&s[0][0], s0);
+    _mm512_storeu_si512(&s[1][0], s1);
+    _mm512_storeu_si512(&s[2][0], s2);
+    _mm512_storeu_si512(&s[3][0], s3);
+
+    if (i < n) {
+        fill_scalar(s, out + i, n - i);
+    }
+}
+
+#endif // GWO_HAVE_X86_SIMD
+
+} // namespace
+
+void VectorRng::fill_uniform(double* out, std::size_t n) {
+    static const SimdIsa isa = detect_simd_isa();
+    fill_uniform(out, n, isa);
+}
+
+void VectorRng::fill_uniform(double* out, std::size_t n, SimdIsa isa) {
+#ifdef GWO_HAVE_X86_SIMD
+    switch (isa) {
+        case SimdIsa::Avx512: fill_avx512(state, out, n); return;
+        case SimdIsa::Avx2: fill_avx2(state, out, n); return;
+        default: break;
+    }
+#else
+    (void)isa;
+#endif
+    fill_scalar(state, out, n);
+}
+
+void VectorRng::fill_uniform(float* out, std::size_t n) {
+    static const SimdIsa isa = detect_simd_isa();
+    fill_uniform(out, n, isa);
+}
+
+void VectorRng::fill_uniform(float* out, std::size_t n, SimdIsa isa) {
+#ifdef GWO_HAVE_X86_SIMD
+    switch (isa) {
+        case SimdIsa::Avx512: fill_avx512(state, out, n); return;
+        case SimdIsa::Avx2: fill_avx2(state, out, n); return;
+        default: break;
+    }
+#else
+    (void)isa;
+#endif
+    fill_scalar(state, out, n);
+}
+
+void VectorRng::jump() {
+    static const std::uint64_t JUMP[] = { 0x180ec6d33cfd0aba, 0xd5a61266f0c9392c, 0xa9582618e03fc9aa, 0x39abdc4529b1661c };
+
+    for (std::size_t lane = 0; lane < lanes; ++lane) {
+        std::uint64_t s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+        std::uint64_t& w0 = state[0][lane];
+        std::uint64_t& w1 = state[1][lane];
+        std::uint64_t& w2 = state[2][lane];
+        std::uint64_t& w3 = state[3][lane];
+
+        for (std::uint64_t word : JUMP) {
+            for (int b = 0; b < 64; ++b) {
+                if (word & (UINT64_C(1) << b)) {
+                    s0 ^= w0;
+                    s1 ^= w1;
+                    s2 ^= w2;
+                    s3 ^= w3;
+                }
+                std::uint64_t t = w1 << 17;
+                w2 ^= w0;
+                w3 ^= w1;
+                w1 ^= w2;
+                w0 ^= w3;
+                w2 ^= t;
+                w3 = rotl(w3, 45);
+            }
+        }
+
+        w0 = s0;
+        w1 = s1;
+        w2 = s2;
+        w3 = s3;
+    }
+}
+
+std::vector<VectorRng> make_streams(std::uint64_t seed, std::size_t count) {
+    std::vector<VectorRng> streams;
+    make_streams(seed, count, streams);
+    return streams;
+}
+
+void make_streams(std::uint64_t seed, std::size_t count, std::vector<VectorRng>& streams) {
+    streams.resize(count);
+
+    VectorRng rng(seed);
+    for (std::size_t k = 0; k < count; ++k) {
+        streams[k] = rng;
+        rng.jump();
+    }
+}
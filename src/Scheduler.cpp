@@ -0,0 +1,136 @@
+#include <algorithm>
+#include <utility>
+
+#include "Scheduler.hpp"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace {
+
+// The pool and worker index of the calling thread, if it is a worker
+thread_local const TaskScheduler* current_pool = nullptr;
+thread_local std::size_t current_worker = 0;
+
+} // namespace
+
+TaskScheduler::TaskScheduler(std::size_t threads, int inner_threads) {
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    workers_.reserve(threads);
+    for (std::size_t i = 0; i < threads; ++i) {
+        workers_.push_back(std::make_unique<Worker>());
+    }
+
+    threads_.reserve(threads);
+    for (std::size_t i = 0; i < threads; ++i) {
+        threads_.emplace_back(&TaskScheduler::run, this, i, inner_threads);
+    }
+}
+
+TaskScheduler::~TaskScheduler() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    work_available_.notify_all();
+
+    for (std::thread& thread : threads_) {
+        thread.join();
+    }
+}
+
+void TaskScheduler::submit(std::function<void()> job) {
+    std::size_t target = current_pool == this
+        ? current_worker
+        : next_.fetch_add(1, std::memory_order_relaxed) % workers_.size();
+
+    {
+        // Counting under the pool mutex means a worker deciding to sleep cannot miss
+        // the job; a worker woken before the push below simply retries.
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++pending_;
+        queued_.fetch_add(1, std::memory_order_release);
+    }
+    {
+        std::lock_guard<std::mutex> lock(workers_[target]->mutex);
+        workers_[target]->jobs.push_back(std::move(job));
+    }
+    work_available_.notify_one();
+}
+
+void TaskScheduler::wait() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    all_done_.wait(lock, [this] { return pending_ == 0; });
+
+    if (error_) {
+        std::exception_ptr error = std::exchange(error_, nullptr);
+        std::rethrow_exception(error);
+    }
+}
+
+bool TaskScheduler::try_pop(std::size_t index, std::function<void()>& job) {
+    // Own jobs first, newest first, for locality
+    {
+        Worker& own = *workers_[index];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.jobs.empty()) {
+            job = std::move(own.jobs.back());
+            own.jobs.pop_back();
+            return true;
+        }
+    }
+
+    // Then steal the oldest job of another worker
+    for (std::size_t offset = 1; offset < workers_.size(); ++offset) {
+        Worker& victim = *workers_[(index + offset) % workers_.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.jobs.empty()) {
+            job = std::move(victim.jobs.front());
+            victim.jobs.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void TaskScheduler::run(std::size_t index, int inner_threads) {
+    current_pool = this;
+    current_worker = index;
+#ifdef _OPENMP
+    omp_set_num_threads(inner_threads);
+#else
+    (void)inner_threads;
+#endif
+
+    for (;;) {
+        std::function<void()> job;
+        if (try_pop(index, job)) {
+            queued_.fetch_sub(1, std::memory_order_acq_rel);
+
+            try {
+                job();
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (!error_) error_ = std::current_exception();
+            }
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (--pending_ == 0) {
+                all_done_.notify_all();
+            }
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        work_available_.wait(lock, [this] {
+            return stopping_ || queued_.load(std::memory_order_acquire) > 0;
+        });
+        if (stopping_ && queued_.load(std::memory_order_acquire) == 0) {
+            return;
+        }
+    }
+}
@@ -0,0 +1,95 @@
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include "Telemetry.hpp"
+
+namespace {
+
+// Header of the binary format
+struct BinaryHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t record_size;
+};
+
+static_assert(sizeof(BinaryHeader) == 16, "The binary header must stay 16 bytes");
+
+constexpr char binary_magic[8] = { 'G', 'W', 'O', 'T', 'L', 'M', '\0', '\0' };
+constexpr std::uint32_t binary_version = 1;
+
+// How long the writer sleeps when the ring is empty
+constexpr std::chrono::microseconds idle_wait(500);
+
+} // namespace
+
+TelemetryStream::TelemetryStream(const std::string& path, TelemetryFormat format, std::size_t capacity)
+    : ring_(capacity),
+      file_(path, format == TelemetryFormat::binary ? std::ios::binary | std::ios::trunc : std::ios::trunc),
+      format_(format) {
+    if (!file_) {
+        throw std::runtime_error("Telemetry file " + path + ": cannot be opened");
+    }
+
+    if (format_ == TelemetryFormat::binary) {
+        BinaryHeader header = {};
+        std::memcpy(header.magic, binary_magic, sizeof(binary_magic));
+        header.version = binary_version;
+        header.record_size = sizeof(IterationSample);
+        file_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    } else {
+        file_ << "run,iteration,evaluations,best_fitness,mean_fitness,diversity,a,"
+                 "evaluation_seconds,update_seconds\n";
+        file_ << std::setprecision(std::numeric_limits<double>::max_digits10);
+    }
+
+    writer_ = std::thread([this] { run(); });
+}
+
+TelemetryStream::~TelemetryStream() {
+    stop_.store(true, std::memory_order_release);
+    writer_.join();
+}
+
+void TelemetryStream::flush() {
+    const long long target = pushed_.load(std::memory_order_acquire);
+    while (written_.load(std::memory_order_acquire) < target) {
+        std::this_thread::sleep_for(idle_wait);
+    }
+}
+
+void TelemetryStream::write(const IterationSample& sample) {
+    if (format_ == TelemetryFormat::binary) {
+        file_.write(reinterpret_cast<const char*>(&sample), sizeof(sample));
+    } else {
+        file_ << sample.run << ',' << sample.iteration << ',' << sample.evaluations << ','
+              << sample.best_fitness << ',' << sample.mean_fitness << ',' << sample.diversity << ','
+              << sample.a << ',' << sample.evaluation_seconds << ',' << sample.update_seconds << '\n';
+    }
+}
+
+void TelemetryStream::run() {
+    IterationSample sample;
+    for (;;) {
+        // Read the flag first, so a sample pushed before the destructor ran is still drained
+        bool stopping = stop_.load(std::memory_order_acquire);
+
+        long long batch = 0;
+        while (ring_.try_pop(sample)) {
+            write(sample);
+            ++batch;
+        }
+        if (batch > 0) {
+            file_.flush();
+            written_.fetch_add(batch, std::memory_order_release);
+        } else if (stopping) {
+            return;
+        } else {
+            std::this_thread::sleep_for(idle_wait);
+        }
+    }
+}
@@ -0,0 +1,54 @@
+#ifndef TEST_SUPPORT_HPP
+#define TEST_SUPPORT_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "functions.hpp"
+
+// Helpers and fixtures shared by the Tests and Benchmark executables
+
+inline int max_threads() {
+#ifdef _OPENMP
+    return omp_get_max_threads();
+#else
+    return 1;
+#endif
+}
+
+inline void set_threads(int threads) {
+#ifdef _OPENMP
+    omp_set_num_threads(threads);
+#else
+    (void)threads;
+#endif
+}
+
+inline double relative_error(double value, double expected) {
+    if (std::isnan(value) || std::isnan(expected)) return std::isnan(value) && std::isnan(expected) ? 0.0 : INFINITY;
+    return std::abs(value - expected) / std::max(1.0, std::abs(expected));
+}
+
+// Branin instances whose coefficients are the usual ones scaled by up to 10%
+inline std::vector<BraninObjective> branin_instances(std::size_t count, std::uint64_t seed) {
+    const std::vector<double> usual = { 1, 1.275 * M_1_PI * M_1_PI, 5 * M_1_PI, 6, 10, 0.125 * M_1_PI };
+    std::mt19937_64 gen(seed);
+    std::uniform_real_distribution<double> scale(0.9, 1.1);
+    std::vector<BraninObjective> instances;
+    for (std::size_t k = 0; k < count; ++k) {
+        std::vector<double> a = usual;
+        for (double& coefficient : a) coefficient *= scale(gen);
+        instances.emplace_back(a);
+    }
+    return instances;
+}
+
+#endif // TEST_SUPPORT_HPP
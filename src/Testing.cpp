@@ -4,27 +4,24 @@
 #include <vector>
 #include <cmath>
 #include <random>
+#include <numeric>
+#include <atomic>
+#include <mutex>
+#include <memory>
+#include <fstream>
 
 #include "functions.hpp"
 #include "GWO.hpp"
+#include "Scheduler.hpp"
+#include "BenchmarkSuite.hpp"
+#include "Telemetry.hpp"
+#include "Profiler.hpp"
 
 using namespace std;
 
-struct BenchmarkFunction {
-    function<double(vector<double>)> func;
-    vector<double> lower_bound;
-    vector<double> upper_bound;
-    string name;
-};
-
-// Función para medir el desempeño de GWO
-void Result_of_Optimization(const function<double(vector<double>)>& optimized_function, const vector<double>& lower_bounds, const vector<double>& upper_bounds, const int& population, const int& iterations, const int& repetitions, mt19937& gen, const string& name) {
-    vector<double> data;
-    for (size_t i = 0; i < repetitions; ++i) {
-        auto [best_position, best_fitness] = GreyWolfOptimizer(optimized_function, lower_bounds, upper_bounds, population, iterations, gen);
-        data.push_back(best_fitness);
-    }
-
+// Imprime las estadísticas de los mejores valores obtenidos por GWO para una función
+void Print_Results(const vector<double>& data, const vector<long long>& evaluations, const string& name) {
+    const size_t repetitions = data.size();
     double maximum = *max_element(data.begin(), data.end());
     double minimum = *min_element(data.begin(), data.end());
     double sum = accumulate(data.begin(), data.end(), 0.0);
@@ -37,100 +34,84 @@ void Result_of_Optimization(const function<double(vector<double>)>& optimized_fu
     cout << "\ta) Valor máximo: " << maximum << "\n";
     cout << "\tb) Valor mínimo: " << minimum << "\n";
     cout << "\tc) Valor promedio: " << mean << "\n";
-    cout << "\td) Desviación estándar: " << std_deviation << endl;
+    cout << "\td) Desviación estándar: " << std_deviation << "\n";
+    cout << "\te) Evaluaciones promedio: "
+         << accumulate(evaluations.begin(), evaluations.end(), 0LL) / static_cast<double>(repetitions) << endl;
+}
+
+// Ejecuta todas las repeticiones de todas las funciones como trabajos independientes.
+// Cada par (función, repetición) tiene su propia semilla, así que los resultados no
+// dependen del orden de ejecución; cada función se imprime en cuanto terminan sus repeticiones.
+void Result_of_Optimization(const vector<BenchmarkFunction>& benchmark_functions, const int& population, const int& iterations, const int& repetitions, const StoppingCriteria& criteria, uint64_t base_seed, TelemetryStream* telemetry) {
+    TaskScheduler scheduler;
+    vector<vector<double>> data(benchmark_functions.size(), vector<double>(repetitions));
+    vector<vector<long long>> evaluations(benchmark_functions.size(), vector<long long>(repetitions));
+    vector<atomic<int>> remaining(benchmark_functions.size());
+    mutex output_mutex;
+
+    for (size_t f = 0; f < benchmark_functions.size(); ++f) {
+        remaining[f] = repetitions;
+        for (int r = 0; r < repetitions; ++r) {
+            scheduler.submit([&, f, r] {
+                thread_local GwoWorkspace workspace; // Reutilizado entre trabajos del mismo hilo
+                const BenchmarkFunction& benchmark = benchmark_functions[f];
+
+                GwoStats stats;
+                const uint64_t seed = derive_seed(base_seed, f, r);
+                double best_fitness;
+                if (telemetry != nullptr) {
+                    // La ejecución número f * repetitions + r en la traza de convergencia
+                    best_fitness = GreyWolfOptimizerT(workspace, benchmark.func, benchmark.lower_bound, benchmark.upper_bound, population, iterations, seed, LinearSchedule(), &stats, criteria, nullptr, telemetry->observer(f * repetitions + r)).second;
+                } else {
+                    best_fitness = GreyWolfOptimizerT(workspace, benchmark.func, benchmark.lower_bound, benchmark.upper_bound, population, iterations, seed, LinearSchedule(), &stats, criteria).second;
+                }
+                data[f][r] = best_fitness;
+                evaluations[f][r] = stats.evaluations;
+
+                if (remaining[f].fetch_sub(1) == 1) {
+                    lock_guard<mutex> lock(output_mutex);
+                    Print_Results(data[f], evaluations[f], benchmark.name);
+                }
+            });
+        }
+    }
+
+    scheduler.wait();
 }
 
-int main() {
+// Uso: Testing [traza.csv]
+// Con un argumento, escribe la curva de convergencia de cada ejecución en ese archivo.
+// Compilado con GWO_PROFILE, escribe además gwo_profile.json
+int main(int argc, char** argv) {
     random_device rd;
     mt19937 gen(rd());
+    uint64_t base_seed = draw_seed(gen);
 
     const int repetitions = 30;
     const int population = 20;
     const int iterations = 1000;
     int dimensions = 20;
 
-    // Definción de parámetros para la función objetivo de Ackley                                                       
-    vector<double> usual_ackley_a = {20, 0.2, 2 * M_PI};                                                                
-    function<double(vector<double>)> bound_ackley = bindAckley(usual_ackley_a);                                         
-
-    // Definición de parámetros para la función objetivo de Langermann
-    vector<vector<double>> usual_langermann_a = {{3, 5}, {5, 2}, {2, 1}, {1, 4}, {7, 9}};
-    vector<double> usual_langermann_c = {1, 2, 5, 2, 3};
-    int langermann_dimension = usual_langermann_a[0].size();
-    function<double(vector<double>)> bound_langermann = bindLangermann(usual_langermann_a, usual_langermann_c);
-
-    // Definición de parámetros para la función objetivo de Michalewicz
-    int m = 10;
-    function<double(vector<double>)> bound_michalewicz = bindMichalewicz(m);
-
-    // Definición de parámetros para la función objetivo de Branin
-    vector<double> usual_branin_a = {1, 1.275*M_1_PI*M_1_PI, 5*M_1_PI, 6, 10, 0.125 * M_1_PI};
-    function<double(vector<double>)> bound_branin = bindBranin(usual_branin_a);
-
-    // Definición de parámetros para la función objetivo de Six-Hump Camel Back
-    vector<double> lowerbound_six_hump_camel_back{-3, -2};
-    vector<double> upperbound_six_hump_camel_back{3, 2};
-
-    // Definición de parámetros para la función objetivo de Shekel
-    vector<vector<double>> usual_foxholes_a{
-        {4.0, 4.0, 4.0, 4.0}
-        ,{1.0, 1.0, 1.0, 1.0}
-        ,{8.0, 8.0, 8.0, 8.0}
-        ,{6.0, 6.0, 6.0, 6.0}
-        ,{3.0, 7.0, 3.0, 7.0}
-        ,{2.0, 9.0, 2.0, 9.0}
-        ,{5.0, 3.0, 5.0, 3.0}
-        ,{8.0, 1.0, 8.0, 1.0}
-        ,{6.0, 2.0, 6.0, 2.0}
-        ,{7.0, 3.6, 7.0, 3.6}
-    };
-    vector<double> usual_foxholes_c {
-        0.1
-        ,0.2
-        ,0.2
-        ,0.4
-        ,0.4
-        ,0.6
-        ,0.3
-        ,0.7
-        ,0.5
-        ,0.5
-    };
-    int foxholes_dimension = usual_foxholes_a[0].size();
-    function<double(vector<double>)> bound_foxhholes = bindShekelFoxholes(usual_foxholes_a, usual_foxholes_c);
-
-
-    vector<BenchmarkFunction> benchmark_functions = {
-        { DeJong, vector<double>(dimensions, -5.12), vector<double>(dimensions, 5.12), "De Jong" },
-        { AxisParallelHyperEllipsoid, vector<double>(dimensions, -5.12), vector<double>(dimensions, 5.12), "Axis Parallel Hyper Ellipsoid" },
-        { RotatedHyperEllipsoid, vector<double>(dimensions, -65.536), vector<double>(dimensions, 65.536), "Rotated Hyper Ellipsoid" },
-        { RosenbrockValley, vector<double>(dimensions, -2.048), vector<double>(dimensions, 2.048), "Rosenbrock Valley" },
-        { Rastring, vector<double>(dimensions, -5.12), vector<double>(dimensions, 5.12), "Rastring" },
-        { Schwefel, vector<double>(dimensions, -500), vector<double>(dimensions, 500), "Schwefel" },
-        { Griewangk, vector<double>(dimensions, -600), vector<double>(dimensions, 600), "Griewangk" },
-        { SumDifferentPower, vector<double>(dimensions, -1), vector<double>(dimensions, 1), "Sum of Different Power" },
-        { bound_ackley, vector<double>(dimensions, -32.768), vector<double>(dimensions, 32.768), "Ackley" },
-        { bound_langermann, vector<double>(langermann_dimension, -10), vector<double>(langermann_dimension, 10), "Langermann" },
-        { bound_michalewicz, vector<double>(dimensions, 0), vector<double>(dimensions, M_PI), "Michalewicz" },
-        { bound_branin, vector<double>(2, -10), vector<double>(2, 10), "Branin" },
-        { GoldsteinPrice, vector<double>(2, -2), vector<double>(2, 2), "Goldstein-Price" },
-        { SixHumpCamelBack, lowerbound_six_hump_camel_back, upperbound_six_hump_camel_back, "Six-Hump Camel" },
-        { FifthDeJong, vector<double>(2, -65.536), vector<double>(2, 65.536), "Fifth De Jong" },
-        { DropWave, vector<double>(2, -5.12), vector<double>(2, -5.12), "Drop Wave" },
-        { Shubert, vector<double>(2, -5.12), vector<double>(2, -5.12), "Shubert" },
-        { bound_foxhholes, vector<double>(foxholes_dimension, 0), vector<double>(foxholes_dimension, 10), "Shekel" }
-    };
-
-    vector<string> function_names = {"De Jong", "Axis Parallel Hyper Ellipsoid", "Rotated Hyper Ellipsoid", 
-        "Rosenbrock Valley", "Rastring", "Schwefel", "Griewangk", "Sum of Different Power", "Ackley",
-        "Langermann", "Michalewicz", "Branin", "Goldstein-Price", "Six-Hump Camel", "Fith De Jong", "Drop Wave", "Shubert",
-        "Shekel"
-    };
-
-     // Evaluate the functions
-     for (const auto& benchmark : benchmark_functions) {
-        Result_of_Optimization(benchmark.func, benchmark.lower_bound, benchmark.upper_bound, population, iterations, repetitions, gen, benchmark.name);
+    // Una repetición termina antes de las 1000 iteraciones si el mejor valor no mejora en 200
+    StoppingCriteria criteria;
+    criteria.stagnation_iterations = 200;
+
+    vector<BenchmarkFunction> benchmark_functions = make_benchmark_functions(dimensions);
+
+    unique_ptr<TelemetryStream> telemetry;
+    if (argc > 1) {
+        telemetry = make_unique<TelemetryStream>(argv[1]);
     }
 
+    // Evaluate the functions
+    Result_of_Optimization(benchmark_functions, population, iterations, repetitions, criteria, base_seed, telemetry.get());
+
+#ifdef GWO_PROFILE
+    // Compilado con GWO_PROFILE: resumen por fase en stderr y traza para chrome://tracing
+    Profiler::instance().write_summary(cerr);
+    ofstream trace("gwo_profile.json");
+    Profiler::instance().write_chrome_trace(trace);
+#endif
+
     return 0;
 }
@@ -0,0 +1,932 @@
+#include <iostream>
+#include <sstream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <random>
+#include <cmath>
+#include <algorithm>
+#include <array>
+#include <numeric>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <filesystem>
+#include <functional>
+#include <stdexcept>
+
+#include <signal.h>
+#include <unistd.h>
+
+#include "AsyncGWO.hpp"
+#include "GWO.hpp"
+#include "GWOCore.hpp"
+#include "BenchmarkSuite.hpp"
+#include "Checkpoint.hpp"
+#include "CooperativeGWO.hpp"
+#include "EvaluationCache.hpp"
+#include "ManyGWO.hpp"
+#include "Numa.hpp"
+#include "ProcessEvaluator.hpp"
+#include "Profiler.hpp"
+#include "CoefficientSet.hpp"
+#include "FixedGWO.hpp"
+#include "IslandGWO.hpp"
+#include "ReferenceFunctions.hpp"
+#include "Telemetry.hpp"
+#include "functions.hpp"
+#include "TestSupport.hpp"
+#include "Pack.hpp"
+#include "Random.hpp"
+#include "UpdateKernel.hpp"
+#include "Simd.hpp"
+
+using namespace std;
+
+// Correctness checks of the optimizers and objectives, one suite per feature. CTest runs
+// every suite as its own test (`Tests <suite>`); `Benchmark` only measures.
+
+// Counts every heap allocation made by the program, to check the optimizer's steady state.
+// The replacements are kept out of line so GCC does not pair an inlined malloc with
+// the delete of another call site and warn about mismatched allocation functions.
+static atomic<long long> allocation_count{0};
+
+__attribute__((noinline)) void* operator new(size_t size) {
+    allocation_count.fetch_add(1, memory_order_relaxed);
+    if (void* memory = malloc(size == 0 ? 1 : size)) return memory;
+    throw bad_alloc();
+}
+
+__attribute__((noinline)) void* operator new(size_t size, align_val_t alignment) {
+    allocation_count.fetch_add(1, memory_order_relaxed);
+    size_t align = static_cast<size_t>(alignment);
+    if (void* memory = aligned_alloc(align, (size + align - 1) / align * align)) return memory;
+    throw bad_alloc();
+}
+
+__attribute__((noinline)) void operator delete(void* memory) noexcept { free(memory); }
+__attribute__((noinline)) void operator delete(void* memory, size_t) noexcept { free(memory); }
+__attribute__((noinline)) void operator delete(void* memory, align_val_t) noexcept { free(memory); }
+__attribute__((noinline)) void operator delete(void* memory, size_t, align_val_t) noexcept { free(memory); }
+
+// ---------------------------------------------------------------------------
+// Objectives: the optimized functions against the reference implementations
+// ---------------------------------------------------------------------------
+
+// Largest accepted |optimized - reference| / max(1, |reference|)
+const double objective_tolerance = 1e-12;
+
+// Largest relative error of `optimized` against `reference` on random points of the
+// optimized function's domain
+double max_objective_error(const BenchmarkFunction& optimized, const BenchmarkFunction& reference) {
+    mt19937 gen(42);
+    vector<double> point(optimized.lower_bound.size());
+    double max_error = 0.0;
+    for (int p = 0; p < 64; ++p) {
+        for (size_t j = 0; j < point.size(); ++j) {
+            uniform_real_distribution<double> dist(optimized.lower_bound[j], optimized.upper_bound[j]);
+            point[j] = dist(gen);
+        }
+        max_error = max(max_error, relative_error(optimized.func(point), reference.func(point)));
+    }
+    return max_error;
+}
+
+// Shekel with a large random set of holes, saved to a file and evaluated from its mapping
+double mapped_shekel_error() {
+    const size_t holes = 2000;
+    const size_t dimension = 4;
+
+    mt19937 gen(7);
+    uniform_real_distribution<double> position(0.0, 10.0), depth(0.1, 1.0);
+    vector<vector<double>> a(holes, vector<double>(dimension));
+    vector<double> c(holes);
+    for (size_t i = 0; i < holes; ++i) {
+        for (double& coordinate : a[i]) coordinate = position(gen);
+        c[i] = depth(gen);
+    }
+
+    string path = (filesystem::temp_directory_path() / ("gwo_shekel_" + to_string(getpid()) + ".bin")).string();
+    CoefficientSet(a, c).save(path);
+    CoefficientSet mapped = CoefficientSet::load(path);
+    filesystem::remove(path);  // The mapping stays valid after the file is unlinked
+
+    BenchmarkFunction optimized = { bindShekelFoxholes(mapped), vector<double>(dimension, 0), vector<double>(dimension, 10), "Shekel" };
+    BenchmarkFunction reference = { bind(reference::ShekelFoxholes, placeholders::_1, a, c), {}, {}, "Shekel" };
+    return max_objective_error(optimized, reference);
+}
+
+bool test_objectives() {
+    const vector<BenchmarkFunction> optimized = make_benchmark_functions(20);
+    const vector<BenchmarkFunction> references = make_reference_functions(20);
+
+    bool within_tolerance = mapped_shekel_error() <= objective_tolerance;
+    for (size_t f = 0; f < optimized.size(); ++f) {
+        within_tolerance = max_objective_error(optimized[f], references[f]) <= objective_tolerance && within_tolerance;
+    }
+    return within_tolerance;
+}
+
+// ---------------------------------------------------------------------------
+// Arguments: runs the optimizer cannot make
+// ---------------------------------------------------------------------------
+
+// True if `run` throws std::invalid_argument
+template <typename Run>
+bool rejects(Run run) {
+    try {
+        run();
+    } catch (const invalid_argument&) {
+        return true;
+    }
+    return false;
+}
+
+// A pack of fewer than 3 wolves and bounds of different sizes must be rejected, by the
+// core and by the asynchronous and island optimizers
+bool test_arguments() {
+    const vector<double> lower(4, -5.12), upper(4, 5.12), short_upper(3, 5.12);
+    GwoWorkspace workspace;
+    FloatGwoWorkspace float_workspace;
+    const function<double(const vector<double>&)> rastring = Rastring;
+
+    return rejects([&] { GreyWolfOptimizerT(workspace, RastringObjective(), lower, upper, 2, 10, 42); })
+        && rejects([&] { GreyWolfOptimizerT(float_workspace, RastringObjective(), lower, upper, 0, 10, 42); })
+        && rejects([&] { GreyWolfOptimizerT(workspace, RastringObjective(), lower, short_upper, 20, 10, 42); })
+        && rejects([&] { GreyWolfOptimizer(rastring, lower, upper, 2, 10, 42); })
+        && rejects([&] { GreyWolfOptimizerAsync(rastring, lower, upper, 0, 100, 42, 1); })
+        && rejects([&] { GreyWolfOptimizerAsync(rastring, lower, upper, -1, 100, 42, 1); })
+        && rejects([&] { GreyWolfOptimizerAsync(rastring, lower, short_upper, 20, 100, 42, 1); })
+        && rejects([&] { GreyWolfOptimizerIslands(rastring, lower, short_upper, 20, 10, 42); })
+        && !rejects([&] { GreyWolfOptimizerT(workspace, RastringObjective(), lower, upper, 3, 10, 42); });
+}
+
+// ---------------------------------------------------------------------------
+// Kernel: the position update on every instruction set, and against the scalar reference
+// ---------------------------------------------------------------------------
+
+// Sweeps of the update over a random pack on every supported instruction set. UpdateKernel.cpp
+// is built without FMA contraction, so every set must give the scalar kernel's positions exactly.
+template <typename Scalar>
+bool kernel_isas_identical(size_t dimension) {
+    const size_t population = 8;
+    BasicPack<Scalar> initial(population, dimension), leaders(3, dimension);
+    VectorRng fill(3);
+    for (BasicPack<Scalar>* target : { &initial, &leaders }) {
+        for (size_t w = 0; w < target->population(); ++w) {
+            Scalar* position = target->position(w);
+            fill.fill_uniform(position, dimension);
+            for (size_t j = 0; j < dimension; ++j) position[j] = Scalar(-5.12) + position[j] * Scalar(10.24);
+        }
+    }
+    const vector<Scalar> lower(dimension, Scalar(-5.12)), upper(dimension, Scalar(5.12));
+    const BasicLeaderPositions<Scalar> leader_positions = { leaders.position(0), leaders.position(1), leaders.position(2) };
+
+    BasicPack<Scalar> scalar_result = initial;
+    for (SimdIsa isa : { SimdIsa::Scalar, SimdIsa::Avx2, SimdIsa::Avx512 }) {
+        if (!simd_isa_supported(isa)) continue;
+        BasicPack<Scalar> pack = initial;
+        VectorRng rng(7);
+        for (int sweep = 0; sweep < 3; ++sweep) {
+            for (size_t w = 0; w < population; ++w) {
+                update_wolf(pack.position(w), leader_positions, lower.data(), upper.data(), dimension, 1.5, rng, isa);
+            }
+        }
+        if (isa == SimdIsa::Scalar) {
+            scalar_result = pack;
+            continue;
+        }
+        for (size_t w = 0; w < population; ++w) {
+            if (!equal(pack.position(w), pack.position(w) + dimension, scalar_result.position(w))) return false;
+        }
+    }
+    return true;
+}
+
+pair<double, double> mean_and_variance(const vector<double>& values) {
+    double mean = accumulate(values.begin(), values.end(), 0.0) / values.size();
+    double variance = 0.0;
+    for (double value : values) variance += (value - mean) * (value - mean);
+    return { mean, variance / (values.size() - 1) };
+}
+
+// The kernel draws its coefficients from `VectorRng` and the original `update_position`
+// path from mt19937, so the two can only agree in distribution. Every coordinate starts
+// from the same position and leaders, so the updated coordinates of all seeds are draws
+// from one distribution. Their means must agree within 5 standard errors and their
+// variances within 2%, about 5 standard errors of the estimate for this many draws.
+bool kernel_matches_reference(double a) {
+    const size_t dimension = 4096;
+    const uint64_t seeds = 64;
+    const double x = 0.7, alpha = 2.0, beta = -1.5, delta = 0.4;
+    // Wide enough that no coordinate is clamped
+    const vector<double> lower(dimension, -100.0), upper(dimension, 100.0);
+    const vector<double> alphas(dimension, alpha), betas(dimension, beta), deltas(dimension, delta);
+    const LeaderPositions leaders = { alphas.data(), betas.data(), deltas.data() };
+
+    vector<double> kernel, reference, position(dimension);
+    kernel.reserve(seeds * dimension);
+    reference.reserve(seeds * dimension);
+    for (uint64_t seed = 1; seed <= seeds; ++seed) {
+        fill(position.begin(), position.end(), x);
+        VectorRng rng(seed);
+        update_wolf(position.data(), leaders, lower.data(), upper.data(), dimension, a, rng);
+        kernel.insert(kernel.end(), position.begin(), position.end());
+
+        mt19937 gen(static_cast<uint32_t>(seed));
+        for (size_t j = 0; j < dimension; ++j) {
+            double X1 = update_position(x, alpha, a, gen);
+            double X2 = update_position(x, beta, a, gen);
+            double X3 = update_position(x, delta, a, gen);
+            reference.push_back(clamp((X1 + X2 + X3) / 3.0, lower[j], upper[j]));
+        }
+    }
+
+    auto [kernel_mean, kernel_variance] = mean_and_variance(kernel);
+    auto [reference_mean, reference_variance] = mean_and_variance(reference);
+    double standard_error = sqrt((kernel_variance + reference_variance) / kernel.size());
+    return abs(kernel_mean - reference_mean) <= 5 * standard_error
+        && abs(kernel_variance / reference_variance - 1.0) <= 0.02;
+}
+
+bool test_kernel() {
+    bool consistent = true;
+    // A short row, one that ends inside a vector, and one spanning several coefficient blocks
+    for (size_t dimension : { 7, 1000, 4109 }) {
+        consistent = kernel_isas_identical<double>(dimension) && consistent;
+        consistent = kernel_isas_identical<float>(dimension) && consistent;
+    }
+    consistent = kernel_matches_reference(2.0) && consistent;
+    consistent = kernel_matches_reference(0.5) && consistent;
+    return consistent;
+}
+
+// ---------------------------------------------------------------------------
+// Precision: float positions
+// ---------------------------------------------------------------------------
+
+// Every instruction set must draw the same float sequence from the same state
+bool float_streams_match() {
+    vector<float> reference(1000), values(1000);
+    VectorRng(5).fill_uniform(reference.data(), reference.size(), SimdIsa::Scalar);
+    for (SimdIsa isa : { SimdIsa::Avx2, SimdIsa::Avx512 }) {
+        if (!simd_isa_supported(isa)) continue;
+        VectorRng(5).fill_uniform(values.data(), values.size(), isa);
+        if (memcmp(values.data(), reference.data(), values.size() * sizeof(float)) != 0) return false;
+    }
+    return all_of(reference.begin(), reference.end(), [](float value) { return value >= 0.0f && value < 1.0f; });
+}
+
+// The best position must be inside the bounds, and evaluating it again must give the
+// fitness reported, up to the reordering of the objective's vectorized sums, which
+// depends on the row's alignment
+template <typename Scalar, typename Objective>
+bool precision_run_consistent(const Objective& objective, double bound) {
+    const int dimension = 2000;
+    const vector<double> lower(dimension, -bound), upper(dimension, bound);
+
+    BasicGwoWorkspace<Scalar> workspace;
+    auto [best_position, best_fitness] = GreyWolfOptimizerT(workspace, objective, lower, upper, 20, 20, 42);
+
+    bool inside = all_of(best_position.begin(), best_position.end(),
+                         [bound](Scalar x) { return x >= -bound && x <= bound; });
+    return inside && relative_error(objective(best_position), best_fitness) <= objective_tolerance;
+}
+
+bool test_precision() {
+    bool consistent = float_streams_match();
+    consistent = precision_run_consistent<double>(RastringObjective(), 5.12) && consistent;
+    consistent = precision_run_consistent<float>(RastringObjective(), 5.12) && consistent;
+    consistent = precision_run_consistent<double>(DeJongObjective(), 5.12) && consistent;
+    consistent = precision_run_consistent<float>(DeJongObjective(), 5.12) && consistent;
+    return consistent;
+}
+
+// ---------------------------------------------------------------------------
+// Fixed: the fixed-dimension optimizer against the general one
+// ---------------------------------------------------------------------------
+
+// Short runs of one problem through `GreyWolfOptimizerT` and `GreyWolfOptimizerFixed`
+// with the same seeds, which must give the same results
+template <size_t Dim, typename Objective>
+bool fixed_matches_general(const Objective& objective, const array<double, Dim>& lower, const array<double, Dim>& upper) {
+    const vector<double> lower_vector(lower.begin(), lower.end()), upper_vector(upper.begin(), upper.end());
+
+    GwoWorkspace workspace;
+    FixedGwoWorkspace<Dim> fixed_workspace;
+    for (int run = 0; run < 20; ++run) {
+        double general = GreyWolfOptimizerT(workspace, objective, lower_vector, upper_vector, 20, 100, run).second;
+        double fixed = GreyWolfOptimizerFixed(fixed_workspace, objective, lower, upper, 20, 100, run).second;
+        if (fixed != general) return false;
+    }
+    return true;
+}
+
+bool test_fixed() {
+    const vector<double> branin_a = { 1, 1.275 * M_1_PI * M_1_PI, 5 * M_1_PI, 6, 10, 0.125 * M_1_PI };
+    const vector<vector<double>> langermann_a = { { 3, 5 }, { 5, 2 }, { 2, 1 }, { 1, 4 }, { 7, 9 } };
+    const vector<double> langermann_c = { 1, 2, 5, 2, 3 };
+    const vector<vector<double>> foxholes_a = {
+        { 4, 4, 4, 4 }, { 1, 1, 1, 1 }, { 8, 8, 8, 8 }, { 6, 6, 6, 6 }, { 3, 7, 3, 7 },
+        { 2, 9, 2, 9 }, { 5, 3, 5, 3 }, { 8, 1, 8, 1 }, { 6, 2, 6, 2 }, { 7, 3.6, 7, 3.6 }
+    };
+    const vector<double> foxholes_c = { 0.1, 0.2, 0.2, 0.4, 0.4, 0.6, 0.3, 0.7, 0.5, 0.5 };
+
+    using Bounds2 = array<double, 2>;
+    bool identical = true;
+    identical = fixed_matches_general(BraninObjective(branin_a), Bounds2{ -10, -10 }, Bounds2{ 10, 10 }) && identical;
+    identical = fixed_matches_general(GoldsteinPriceObjective(), Bounds2{ -2, -2 }, Bounds2{ 2, 2 }) && identical;
+    identical = fixed_matches_general(SixHumpCamelBackObjective(), Bounds2{ -3, -2 }, Bounds2{ 3, 2 }) && identical;
+    identical = fixed_matches_general(FifthDeJongObjective(), Bounds2{ -65.536, -65.536 }, Bounds2{ 65.536, 65.536 })
+        && identical;
+    identical = fixed_matches_general(DropWaveObjective(), Bounds2{ -5.12, -5.12 }, Bounds2{ 5.12, 5.12 }) && identical;
+    identical = fixed_matches_general(ShubertObjective(), Bounds2{ -5.12, -5.12 }, Bounds2{ 5.12, 5.12 }) && identical;
+    identical = fixed_matches_general(LangermannObjective(langermann_a, langermann_c),
+                                      Bounds2{ -10, -10 }, Bounds2{ 10, 10 }) && identical;
+    identical = fixed_matches_general(ShekelFoxholesObjective(foxholes_a, foxholes_c),
+                                      array<double, 4>{ 0, 0, 0, 0 }, array<double, 4>{ 10, 10, 10, 10 }) && identical;
+    return identical;
+}
+
+// ---------------------------------------------------------------------------
+// Many: a batch of small instances solved in one call
+// ---------------------------------------------------------------------------
+
+// Every instance's result must match its objective and counters, and must not change
+// when the other instances of the batch change
+bool test_many() {
+    const size_t instances = 64;
+    const int population = 20;
+    const int iterations = 100;
+    const vector<double> lower = { -10, -10 }, upper = { 10, 10 };
+    StoppingCriteria criteria;
+    criteria.stagnation_iterations = iterations / 4;
+
+    const vector<BraninObjective> objectives = branin_instances(instances, 7);
+    const vector<InstanceResult> results = GreyWolfOptimizerMany(objectives, lower, upper, population, iterations, 42,
+                                                                 LinearSchedule(), criteria);
+
+    bool consistent = true;
+    for (size_t k = 0; k < instances; ++k) {
+        const InstanceResult& result = results[k];
+        consistent = consistent && objectives[k](Span<const double>(result.best_position)) == result.best_fitness
+            && result.stats.evaluations == static_cast<long long>(result.stats.iterations) * population;
+    }
+
+    // Replacing every odd instance must leave the even ones exactly as they were
+    vector<BraninObjective> mixed = objectives;
+    const vector<BraninObjective> others = branin_instances(instances, 8);
+    for (size_t k = 1; k < instances; k += 2) mixed[k] = others[k];
+    const vector<InstanceResult> mixed_results = GreyWolfOptimizerMany(mixed, lower, upper, population, iterations, 42,
+                                                                       LinearSchedule(), criteria);
+    for (size_t k = 0; k < instances; k += 2) {
+        consistent = consistent && mixed_results[k].best_fitness == results[k].best_fitness
+            && mixed_results[k].best_position == results[k].best_position;
+    }
+    return consistent;
+}
+
+// ---------------------------------------------------------------------------
+// Cooperative: block-wise coevolution, incremental and full evaluation
+// ---------------------------------------------------------------------------
+
+// The fitness of every run must match a full evaluation of the context it returns
+bool test_cooperative() {
+    const int population = 10;
+    const size_t block_size = 500;
+    const size_t dimension = 20000;
+    const double tolerance = 1e-9;
+
+    bool consistent = true;
+    CooperativeGwoWorkspace workspace;
+    auto run = [&](size_t run_dimension, double bound, auto objective, auto evaluate) {
+        const vector<double> lower(run_dimension, -bound), upper(run_dimension, bound);
+        auto [context, fitness] = GreyWolfOptimizerCooperative(workspace, objective, lower, upper, block_size,
+                                                               population, 1, 5, 42);
+        consistent = consistent && relative_error(fitness, evaluate(context)) <= tolerance;
+    };
+
+    const RastringObjective rastring;
+    const DeJongObjective dejong;
+    const SchwefelObjective schwefel;
+    auto full_rastring = [&rastring](Span<const double> x) { return rastring(x); };
+
+    run(dimension, 5.12, rastring, rastring);
+    run(dimension, 5.12, dejong, dejong);
+    run(dimension, 500, schwefel, schwefel);
+    // Without `partial`, every block change costs a full evaluation
+    run(dimension / 4, 5.12, full_rastring, rastring);
+
+    // A smaller team on a larger dimension must still size the rows of the larger team
+    const int default_threads = max_threads();
+    set_threads(4);
+    run(8, 5.12, full_rastring, rastring);
+    set_threads(1);
+    run(4000, 5.12, full_rastring, rastring);
+    set_threads(default_threads);
+    for (const vector<double>& row : workspace.scratch) {
+        consistent = consistent && row.size() == 4000;
+    }
+    return consistent;
+}
+
+// ---------------------------------------------------------------------------
+// NUMA: the NUMA-aware mode against the default one
+// ---------------------------------------------------------------------------
+
+// A NUMA-aware run on pinned threads must match the default run with the same seed, on
+// one node and on all of them
+bool test_numa() {
+    const int dimension = 1000;
+    const vector<double> lower(dimension, -5.12), upper(dimension, 5.12);
+    const int default_threads = max_threads();
+    const NumaTopology topology = NumaTopology::detect();
+
+    vector<size_t> node_counts = { 1 };
+    if (topology.nodes() > 1) node_counts.push_back(topology.nodes());
+
+    bool identical = true;
+    for (size_t nodes : node_counts) {
+        const NumaTopology used = topology.first_nodes(nodes);
+        const ThreadPlacement placement = pin_threads(used, ThreadPinning::compact, static_cast<int>(used.cpus()));
+
+        GwoWorkspace workspace, aware_workspace;
+        aware_workspace.placement = &placement;
+        auto [position, fitness] = GreyWolfOptimizerT(workspace, DeJongObjective(), lower, upper, 64, 10, 42);
+        auto [aware_position, aware_fitness] = GreyWolfOptimizerT(aware_workspace, DeJongObjective(), lower, upper,
+                                                                  64, 10, 42);
+        identical = identical && aware_fitness == fitness
+            && equal(aware_position.begin(), aware_position.end(), position.begin());
+    }
+
+    unpin_threads();
+    set_threads(default_threads);
+    return identical;
+}
+
+// ---------------------------------------------------------------------------
+// Islands: several packs exchanging their best wolves
+// ---------------------------------------------------------------------------
+
+// Without migration the islands are independent, so the same seed must give the same
+// run; with or without it, every island must spend its whole budget and the result must
+// be the best of the islands
+bool test_islands() {
+    const int dimension = 30;
+    const int population = 20;
+    const int iterations = 50;
+    const vector<double> lower(dimension, -5.12), upper(dimension, 5.12);
+    const function<double(const vector<double>&)> objective = Rastring;
+
+    IslandOptions options;
+    options.islands = 4;
+
+    bool consistent = true;
+    auto run = [&](IslandStats& stats) {
+        auto result = GreyWolfOptimizerIslands(objective, lower, upper, population, iterations, 42, options,
+                                               compute_a, &stats);
+        consistent = consistent
+            && stats.totals.evaluations == static_cast<long long>(options.islands) * population * iterations
+            && stats.best_fitness.size() == options.islands
+            && result.second == *min_element(stats.best_fitness.begin(), stats.best_fitness.end());
+        return result;
+    };
+
+    for (IslandTopology topology : { IslandTopology::ring, IslandTopology::fully_connected }) {
+        IslandStats stats;
+        options.migration_interval = 10;
+        options.topology = topology;
+        run(stats);
+    }
+
+    options.migration_interval = 0;
+    IslandStats first_stats, second_stats;
+    auto first = run(first_stats);
+    auto second = run(second_stats);
+    consistent = consistent && first == second && first_stats.best_fitness == second_stats.best_fitness;
+    return consistent;
+}
+
+#ifdef __linux__
+// ---------------------------------------------------------------------------
+// Processes: a non-thread-safe objective evaluated in forked worker processes
+// ---------------------------------------------------------------------------
+
+// Rastring through a global buffer, like a legacy objective that cannot run on two
+// threads at once
+vector<double> legacy_buffer;
+
+double legacy_rastring(const vector<double>& x) {
+    legacy_buffer.assign(x.begin(), x.end());
+    return RastringObjective()(legacy_buffer);
+}
+
+// Calls since the worker was forked; the parent never evaluates, so every replacement starts at 0
+long long legacy_calls = 0;
+
+double crashing_rastring(const vector<double>& x) {
+    if (++legacy_calls % 100 == 0) raise(SIGKILL);
+    return legacy_rastring(x);
+}
+
+// A pool of worker processes must give the serial in-process result, and workers that
+// die every 100 evaluations must be counted as failures and replaced. With 4 workers,
+// at least one of them makes 100 of the 640 evaluations.
+bool test_processes() {
+    const int workers = 4;
+    const int population = 32;
+    const int iterations = 20;
+    const int dimension = 30;
+    const vector<double> lower(dimension, -5.12), upper(dimension, 5.12);
+    const int default_threads = max_threads();
+
+    set_threads(1);
+    const function<double(const vector<double>&)> objective = legacy_rastring;
+    const double serial_fitness = GreyWolfOptimizerT(objective, lower, upper, population, iterations, 42).second;
+    set_threads(default_threads);
+
+    ProcessEvaluator evaluator(legacy_rastring, dimension, population, workers);
+    const double pooled_fitness = GreyWolfOptimizerT(evaluator, lower, upper, population, iterations, 42).second;
+
+    ProcessEvaluator crashing(crashing_rastring, dimension, population, workers);
+    GreyWolfOptimizerT(crashing, lower, upper, population, iterations, 42);
+
+    return pooled_fitness == serial_fitness && evaluator.stats().failures == 0
+        && crashing.stats().restarts > 0 && crashing.stats().failures > 0;
+}
+#endif
+
+// ---------------------------------------------------------------------------
+// Async: the steady-state optimizer
+// ---------------------------------------------------------------------------
+
+// A run must use exactly its evaluation budget, count the whole passes over the pack as
+// iterations, and return a fitness that evaluating its position again reproduces. The
+// budget is not a multiple of the population, to cover a last partial pass.
+bool test_async() {
+    const int population = 16;
+    const int max_evaluations = population * 25 + 7;
+    const int dimension = 10;
+    const vector<double> lower(dimension, -5.12), upper(dimension, 5.12);
+    const function<double(const vector<double>&)> objective = Rastring;
+
+    GwoStats stats;
+    auto [position, fitness] = GreyWolfOptimizerAsync(objective, lower, upper, population, max_evaluations, 42,
+                                                      4, compute_a, &stats);
+    bool inside = true;
+    for (int j = 0; j < dimension; ++j) {
+        inside = inside && position[j] >= lower[j] && position[j] <= upper[j];
+    }
+    return stats.evaluations == max_evaluations && stats.iterations == max_evaluations / population
+        && stats.stop_reason == StopReason::max_evaluations && inside && objective(position) == fitness;
+}
+
+// ---------------------------------------------------------------------------
+// Cache: objective values looked up in an evaluation cache
+// ---------------------------------------------------------------------------
+
+// An objective whose evaluation looks up another cache on the same thread must still be
+// stored under its own position. The outer cache has one shard, so an entry stored
+// under the inner lookup's key would be found by the next outer lookup of that point.
+bool nested_caches_consistent() {
+    const function<double(const vector<double>&)> sphere = DeJong;
+    auto doubled = [](vector<double> x) {
+        for (double& xi : x) xi *= 2.0;
+        return x;
+    };
+    auto direct = [&](const vector<double>& x) { return sphere(doubled(x)) + 1.0; };
+
+    EvaluationCache inner_cache, outer_cache(0.0, 1024, 1);
+    const function<double(const vector<double>&)> inner = make_cached_objective(sphere, inner_cache);
+    const function<double(const vector<double>&)> outer = make_cached_objective(
+        [&](const vector<double>& x) { return inner(doubled(x)) + 1.0; }, outer_cache);
+
+    bool consistent = true;
+    for (vector<double> x : { vector<double>{ 0.25, -1.0 }, vector<double>{ 1.5, 0.75 } }) {
+        for (int repeat = 0; repeat < 3; ++repeat) {
+            consistent = consistent && outer(x) == direct(x);
+            x = doubled(x);
+        }
+    }
+    return consistent;
+}
+
+// A sphere centered outside the search box, so the pack keeps evaluating the same
+// clamped points. An exact cache must not change the run in any bit; a tolerant one
+// may return the value of a point up to `tolerance` away in every coordinate. Every
+// evaluation must be either an objective call or a hit.
+bool cached_runs_consistent() {
+    const int population = 30;
+    const int iterations = 50;
+    const int dimension = 2;
+    const vector<double> lower(dimension, -5.0), upper(dimension, 5.0);
+
+    atomic<long long> calls{0};
+    auto sphere = [](const vector<double>& x) {
+        double sum = 0.0;
+        for (double xi : x) sum += (xi - 10.0) * (xi - 10.0);
+        return sum;
+    };
+    const function<double(const vector<double>&)> objective = [&calls, &sphere](const vector<double>& x) {
+        calls.fetch_add(1, memory_order_relaxed);
+        return sphere(x);
+    };
+
+    const auto uncached = GreyWolfOptimizer(objective, lower, upper, population, iterations, 42);
+
+    bool consistent = true;
+    for (double tolerance : { 0.0, 1e-3 }) {
+        EvaluationCache cache(tolerance);
+        calls = 0;
+        GwoStats stats;
+        const auto [position, fitness] = GreyWolfOptimizer(make_cached_objective(objective, cache), lower, upper,
+                                                           population, iterations, 42, compute_a, &stats);
+        consistent = consistent && calls.load() + cache.stats().hits == stats.evaluations;
+
+        if (tolerance == 0.0) {
+            consistent = consistent && memcmp(&fitness, &uncached.second, sizeof(double)) == 0
+                && memcmp(position.data(), uncached.first.data(), dimension * sizeof(double)) == 0;
+        } else {
+            // Largest change of the sphere over a grid cell around `position`
+            double bound = 0.0;
+            for (double xi : position) bound += 2.0 * abs(xi - 10.0) * tolerance + tolerance * tolerance;
+            consistent = consistent && abs(fitness - sphere(position)) <= bound;
+        }
+    }
+    return consistent;
+}
+
+bool test_cache() {
+    bool consistent = nested_caches_consistent();
+    consistent = cached_runs_consistent() && consistent;
+    return consistent;
+}
+
+// ---------------------------------------------------------------------------
+// Stopping: each stopping criterion alone
+// ---------------------------------------------------------------------------
+
+// Runs each criterion alone on a problem where it is the first to trigger. Every run
+// must stop for its criterion's reason and stay within its evaluation budget.
+bool test_stopping() {
+    const int population = 20;
+    const int dimension = 10;
+    const int iterations = 2000;
+    const vector<double> lower(dimension, -5.12), upper(dimension, 5.12);
+
+    struct Case {
+        StopReason expected;
+        StoppingCriteria criteria;
+        bool multimodal;
+    };
+    vector<Case> cases(6);
+    cases[0] = { StopReason::iterations, {}, false };
+    cases[1] = { StopReason::target_fitness, {}, false };
+    cases[1].criteria.target_fitness = 1e-8;
+    cases[2] = { StopReason::stagnation, {}, true };
+    cases[2].criteria.stagnation_iterations = 50;
+    cases[2].criteria.stagnation_tolerance = 1e-9;
+    cases[3] = { StopReason::diversity, {}, false };
+    cases[3].criteria.min_diversity = 1e-6;
+    cases[4] = { StopReason::max_evaluations, {}, false };
+    cases[4].criteria.max_evaluations = 1010;
+    cases[5] = { StopReason::deadline, {}, true };
+    cases[5].criteria.max_seconds = 0.005;
+    // Without any criterion the run must go through every iteration, so keep it short;
+    // the deadline must come first even on a fast machine, so give it plenty
+    const int unbounded_iterations = 200;
+    const int deadline_iterations = 1000000;
+
+    bool all_expected = true;
+    for (const Case& test : cases) {
+        const function<double(const vector<double>&)> objective =
+            test.multimodal ? function<double(const vector<double>&)>(Rastring) : DeJong;
+        int cap = test.expected == StopReason::iterations ? unbounded_iterations
+                : test.expected == StopReason::deadline ? deadline_iterations : iterations;
+
+        GwoStats stats;
+        GreyWolfOptimizer(objective, lower, upper, population, cap, 42, compute_a, &stats, test.criteria);
+
+        bool within_budget = test.criteria.max_evaluations == 0 || stats.evaluations <= test.criteria.max_evaluations;
+        all_expected = all_expected && stats.stop_reason == test.expected && within_budget;
+    }
+    return all_expected;
+}
+
+// ---------------------------------------------------------------------------
+// Checkpoint: resuming an interrupted run
+// ---------------------------------------------------------------------------
+
+// Interrupts a run halfway through with an evaluation budget and resumes it from its
+// last checkpoint. A checkpointed run and the resumed run must both match an
+// uninterrupted run in every bit.
+bool test_checkpoint() {
+    const int population = 30;
+    const int dimension = 20;
+    const int iterations = 100;
+    const int interval = 10;
+    const vector<double> lower(dimension, -5.12), upper(dimension, 5.12);
+    const function<double(const vector<double>&)> objective = Rastring;
+    const string path = (filesystem::temp_directory_path() / ("gwo_checkpoint_" + to_string(getpid()) + ".bin")).string();
+
+    auto run = [&](Checkpointer* checkpointer, const StoppingCriteria& criteria) {
+        return GreyWolfOptimizer(objective, lower, upper, population, iterations, 42, compute_a, nullptr,
+                                 criteria, checkpointer);
+    };
+
+    auto uninterrupted = run(nullptr, {});
+
+    filesystem::remove(path);
+    pair<vector<double>, double> checkpointed;
+    {
+        Checkpointer checkpointer(path, interval);
+        checkpointed = run(&checkpointer, {});
+    }
+
+    // Stop after a little more than half the iterations, then resume from the last snapshot
+    filesystem::remove(path);
+    StoppingCriteria interruption;
+    interruption.max_evaluations = static_cast<long long>(population) * (iterations / 2 + interval / 2);
+    {
+        Checkpointer checkpointer(path, interval);
+        run(&checkpointer, interruption);
+    }
+    pair<vector<double>, double> resumed;
+    {
+        Checkpointer checkpointer(path, interval);
+        resumed = run(&checkpointer, {});
+    }
+
+    // Adding 2^61 to the dimension (the fifth word of the header) leaves the size it
+    // implies unchanged modulo 2^64; the loader must reject it before allocating
+    bool rejected = false;
+    {
+        fstream file(path, ios::in | ios::out | ios::binary);
+        uint64_t dimension_word;
+        file.seekg(32);
+        file.read(reinterpret_cast<char*>(&dimension_word), sizeof(dimension_word));
+        dimension_word += uint64_t(1) << 61;
+        file.seekp(32);
+        file.write(reinterpret_cast<const char*>(&dimension_word), sizeof(dimension_word));
+    }
+    try {
+        GwoCheckpoint state;
+        read_checkpoint(path, state);
+    } catch (const runtime_error&) {
+        rejected = true;
+    }
+    filesystem::remove(path);
+
+    return checkpointed == uninterrupted && resumed == uninterrupted && rejected;
+}
+
+// ---------------------------------------------------------------------------
+// Telemetry: one sample per iteration
+// ---------------------------------------------------------------------------
+
+// Every iteration must be either written or counted as dropped, in both formats
+bool test_telemetry() {
+    const int dimension = 30;
+    const int iterations = 200;
+    const vector<double> lower(dimension, -5.12), upper(dimension, 5.12);
+    const string path = (filesystem::temp_directory_path() / ("gwo_telemetry_" + to_string(getpid()))).string();
+
+    bool complete = true;
+    GwoWorkspace workspace;
+    for (TelemetryFormat format : { TelemetryFormat::csv, TelemetryFormat::binary }) {
+        TelemetryStream stream(path, format);
+        GreyWolfOptimizerT(workspace, RastringObjective(), lower, upper, 30, iterations, 42,
+                           LinearSchedule(), nullptr, StoppingCriteria(), nullptr, stream.observer());
+        stream.flush();
+        complete = complete && stream.written() + stream.dropped() == iterations;
+    }
+    filesystem::remove(path);
+    return complete;
+}
+
+// ---------------------------------------------------------------------------
+// Profile: the built-in profiler's counts against the run's statistics
+// ---------------------------------------------------------------------------
+
+#ifdef GWO_PROFILE
+// The profiler's counts of one run must match the run's statistics, and its trace must
+// contain the per-thread update phase
+bool test_profile() {
+    const int dimension = 256;
+    const vector<double> lower(dimension, -5.12), upper(dimension, 5.12);
+    Profiler& profiler = Profiler::instance();
+
+    profiler.set_enabled(true);
+    profiler.reset();
+    GwoStats stats;
+    GreyWolfOptimizerT(RastringObjective(), lower, upper, 30, 200, 42, LinearSchedule(), &stats);
+    bool consistent = profiler.counter(ProfileCounter::evaluations) == stats.evaluations
+                   && profiler.counter(ProfileCounter::iterations) == stats.iterations
+                   && profiler.totals(ProfilePhase::evaluation).calls == stats.iterations
+                   && profiler.totals(ProfilePhase::update).calls == stats.iterations
+                   && profiler.totals(ProfilePhase::update_thread).calls >= stats.iterations;
+    ostringstream trace;
+    profiler.write_chrome_trace(trace);
+    consistent = consistent && trace.str().find("\"update_thread\"") != string::npos;
+    profiler.reset();
+    return consistent;
+}
+#endif
+
+// ---------------------------------------------------------------------------
+// Allocations: heap traffic of steady-state runs in one workspace
+// ---------------------------------------------------------------------------
+
+// Runs the optimizer repeatedly in one workspace; no run after the first may allocate
+bool test_allocations() {
+    const vector<double> lower(64, -5.12), upper(64, 5.12);
+    const function<double(const vector<double>&)> rastring = Rastring;
+    GwoWorkspace workspace;
+
+    // Warm-up: sizes the workspace and lets OpenMP create its thread team
+    GreyWolfOptimizerT(workspace, RastringObjective(), lower, upper, 20, 50, 1);
+    GreyWolfOptimizerT(workspace, rastring, lower, upper, 20, 50, 1);
+
+    long long before = allocation_count.load();
+    for (uint64_t seed = 2; seed < 12; ++seed) {
+        GreyWolfOptimizerT(workspace, RastringObjective(), lower, upper, 20, 50, seed);
+        GreyWolfOptimizerT(workspace, rastring, lower, upper, 20, 50, seed);
+    }
+    return allocation_count.load() == before;
+}
+
+// ---------------------------------------------------------------------------
+// Suites
+// ---------------------------------------------------------------------------
+
+struct Suite {
+    const char* name;
+    bool (*run)();
+    const char* failure;  // Printed when `run` returns false
+};
+
+const Suite suites[] = {
+    { "objectives", test_objectives, "Optimized objectives differ from the reference implementations by more than 1e-12" },
+    { "arguments", test_arguments, "The optimizer accepted a pack of fewer than 3 wolves or bounds of different sizes" },
+    { "kernel", test_kernel, "The update kernels differ between instruction sets, or from the distribution of update_position" },
+    { "precision", test_precision, "The float random streams differ between instruction sets, or a float run left its bounds" },
+    { "fixed", test_fixed, "A fixed-dimension run differs from the same run of the general optimizer" },
+    { "many", test_many, "A batch-solved instance misreported its result or depended on the other instances" },
+    { "cooperative", test_cooperative, "A cooperative run's fitness differs from a full evaluation of its result" },
+    { "numa", test_numa, "A NUMA-aware run differs from the default run with the same seed" },
+    { "islands", test_islands, "An island run did not spend its budget, misreported its best island, or was not reproducible without migration" },
+#ifdef __linux__
+    { "processes", test_processes, "Evaluation in worker processes differs from in-process evaluation, or did not survive a crash" },
+#endif
+    { "async", test_async, "An asynchronous run did not use its whole budget, or misreported its result" },
+    { "cache", test_cache, "The evaluation cache returned the value of another position, or misreported its lookups" },
+    { "stopping", test_stopping, "A run stopped for another reason than its stopping criterion, or exceeded its budget" },
+    { "checkpoint", test_checkpoint, "A run resumed from a checkpoint differs from the uninterrupted run, or a corrupt header was loaded" },
+    { "telemetry", test_telemetry, "The telemetry stream did not record one sample per iteration" },
+#ifdef GWO_PROFILE
+    { "profile", test_profile, "The profiler's counts differ from the run's statistics, or its trace misses a phase" },
+#endif
+    { "allocations", test_allocations, "Steady-state runs performed heap allocations" },
+};
+
+const Suite* find_suite(const string& name) {
+    for (const Suite& suite : suites) {
+        if (name == suite.name) return &suite;
+    }
+    return nullptr;
+}
+
+// Usage: Tests [--list] [SUITE...]. Runs the given suites, or all of them, and fails if any fails.
+int main(int argc, char** argv) {
+    vector<const Suite*> selected;
+    for (int i = 1; i < argc; ++i) {
+        string argument = argv[i];
+        if (argument == "--list") {
+            for (const Suite& suite : suites) cout << suite.name << "\n";
+            return 0;
+        }
+        const Suite* suite = find_suite(argument);
+        if (suite == nullptr) {
+            cerr << "Usage: " << argv[0] << " [--list] [SUITE...]\nSuites:";
+            for (const Suite& known : suites) cerr << " " << known.name;
+            cerr << "\n";
+            return argument == "--help" ? 0 : 2;
+        }
+        selected.push_back(suite);
+    }
+    if (selected.empty()) {
+        for (const Suite& suite : suites) selected.push_back(&suite);
+    }
+
+    int status = 0;
+    for (const Suite* suite : selected) {
+        bool passed = suite->run();
+        cout << suite->name << ": " << (passed ? "passed" : "FAILED") << endl;
+        if (!passed) {
+            cerr << suite->failure << "\n";
+            status = 1;
+        }
+    }
+    return status;
+}
@@ -0,0 +1,269 @@
+#include <algorithm>
+#include <cmath>
+
+#include "UpdateKernel.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define GWO_HAVE_X86_SIMD 1
+#endif
+
+#if defined(__GNUC__) && !defined(__clang__)
+// GCC 12 warns about the _mm512_undefined_* placeholders inside its own AVX-512 intrinsics
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+namespace {
+
+// Coefficients of one block: r1 and r2 for alpha, beta and delta, each `count` long
+template <typename T>
+struct BlockRandoms {
+    const T* r1_alpha;
+    const T* r2_alpha;
+    const T* r1_beta;
+    const T* r2_beta;
+    const T* r1_delta;
+    const T* r2_delta;
+
+    BlockRandoms(const T* random, std::size_t count)
+        : r1_alpha(random), r2_alpha(random + count),
+          r1_beta(random + 2 * count), r2_beta(random + 3 * count),
+          r1_delta(random + 4 * count), r2_delta(random + 5 * count) {}
+};
+
+template <typename T>
+inline T pull(T wolf_pos, T leader_pos, T a, T r1, T r2) {
+    T A = 2 * a * r1 - a;
+    T C = 2 * r2;
+    T D = std::fabs(C * leader_pos - wolf_pos);
+    return leader_pos - A * D;
+}
+
+template <typename T>
+inline void update_one(T* position, const BasicLeaderPositions<T>& leaders,
+                       const T* lower, const T* upper,
+                       const BlockRandoms<T>& r, T a, std::size_t j) {
+    T X1 = pull(position[j], leaders.alpha[j], a, r.r1_alpha[j], r.r2_alpha[j]); // Alpha's Influence on the wolf
+    T X2 = pull(position[j], leaders.beta[j], a, r.r1_beta[j], r.r2_beta[j]);    // Beta's Influence on the wolf
+    T X3 = pull(position[j], leaders.delta[j], a, r.r1_delta[j], r.r2_delta[j]); // Delta's Influence on the wolf
+
+    position[j] = std::clamp((X1 + X2 + X3) / T(3), lower[j], upper[j]);
+}
+
+template <typename T>
+void update_block_scalar(T* position, const BasicLeaderPositions<T>& leaders,
+                         const T* lower, const T* upper,
+                         const BlockRandoms<T>& r, T a, std::size_t count) {
+    for (std::size_t j = 0; j < count; ++j) {
+        update_one(position, leaders, lower, upper, r, a, j);
+    }
+}
+
+#ifdef GWO_HAVE_X86_SIMD
+
+__attribute__((target("avx2")))
+inline __m256d pull_avx2(__m256d x, __m256d leader, __m256d a, __m256d r1, __m256d r2) {
+    const __m256d two = _mm256_set1_pd(2.0);
+    const __m256d sign = _mm256_set1_pd(-0.0);
+    __m256d A = _mm256_sub_pd(_mm256_mul_pd(_mm256_mul_pd(two, a), r1), a);
+    __m256d C = _mm256_mul_pd(two, r2);
+    __m256d D = _mm256_andnot_pd(sign, _mm256_sub_pd(_mm256_mul_pd(C, leader), x));
+    return _mm256_sub_pd(leader, _mm256_mul_pd(A, D));
+}
+
+__attribute__((target("avx2")))
+void update_block_avx2(double* position, const LeaderPositions& leaders,
+                       const double* lower, const double* upper,
+                       const BlockRandoms<double>& r, double a, std::size_t count) {
+    const __m256d va = _mm256_set1_pd(a);
+    const __m256d three = _mm256_set1_pd(3.0);
+
+    std::size_t j = 0;
+    for (; j + 4 <= count; j += 4) {
+        __m256d x = _mm256_loadu_pd(position + j);
+        __m256d X1 = pull_avx2(x, _mm256_loadu_pd(leaders.alpha + j), va,
+                               _mm256_loadu_pd(r.r1_alpha + j), _mm256_loadu_pd(r.r2_alpha + j));
+        __m256d X2 = pull_avx2(x, _mm256_loadu_pd(leaders.beta + j), va,
+                               _mm256_loadu_pd(r.r1_beta + j), _mm256_loadu_pd(r.r2_beta + j));
+        __m256d X3 = pull_avx2(x, _mm256_loadu_pd(leaders.delta + j), va,
+                               _mm256_loadu_pd(r.r1_delta + j), _mm256_loadu_pd(r.r2_delta + j));
+
+        __m256d mean = _mm256_div_pd(_mm256_add_pd(_mm256_add_pd(X1, X2), X3), three);
+        mean = _mm256_max_pd(mean, _mm256_loadu_pd(lower + j));
+        mean = _mm256_min_pd(mean, _mm256_loadu_pd(upper + j));
+        _mm256_storeu_pd(position + j, mean);
+    }
+    for (; j < count; ++j) {
+        update_one(position, leaders, lower, upper, r, a, j);
+    }
+}
+
+__attribute__((target("avx512f")))
+inline __m512d pull_avx512(__m512d x, __m512d leader, __m512d a, __m512d r1, __m512d r2) {
+    const __m512d two = _mm512_set1_pd(2.0);
+    __m512d A = _mm512_sub_pd(_mm512_mul_pd(_mm512_mul_pd(two, a), r1), a);
+    __m512d C = _mm512_mul_pd(two, r2);
+    __m512d D = _mm512_abs_pd(_mm512_sub_pd(_mm512_mul_pd(C, leader), x));
+    return _mm512_sub_pd(leader, _mm512_mul_pd(A, D));
+}
+
+__attribute__((target("avx512f")))
+void update_block_avx512(double* position, const LeaderPositions& leaders,
+                         const double* lower, const double* upper,
+                         const BlockRandoms<double>& r, double a, std::size_t count) {
+    const __m512d va = _mm512_set1_pd(a);
+    const __m512d three = _mm512_set1_pd(3.0);
+
+    std::size_t j = 0;
+    for (; j + 8 <= count; j += 8) {
+        __m512d x = _mm512_loadu_pd(position + j);
+        __m512d X1 = pull_avx512(x, _mm512_loadu_pd(leaders.alpha + j), va,
+                                 _mm512_loadu_pd(r.r1_alpha + j), _mm512_loadu_pd(r.r2_alpha + j));
+        __m512d X2 = pull_avx512(x, _mm512_loadu_pd(leaders.beta + j), va,
+                                 _mm512_loadu_pd(r.r1_beta + j), _mm512_loadu_pd(r.r2_beta + j));
+        __m512d X3 = pull_avx512(x, _mm512_loadu_pd(leaders.delta + j), va,
+                                 _mm512_loadu_pd(r.r1_delta + j), _mm512_loadu_pd(r.r2_delta + j));
+
+        __m512d mean = _mm512_div_pd(_mm512_add_pd(_mm512_add_pd(X1, X2), X3), three);
+        mean = _mm512_max_pd(mean, _mm512_loadu_pd(lower + j));
+        mean = _mm512_min_pd(mean, _mm512_loadu_pd(upper + j));
+        _mm512_storeu_pd(position + j, mean);
+    }
+    for (; j < count; ++j) {
+        update_one(position, leaders, lower, upper, r, a, j);
+    }
+}
+
+__attribute__((target("avx2")))
+inline __m256 pull_avx2(__m256 x, __m256 leader, __m256 a, __m256 r1, __m256 r2) {
+    const __m256 two = _mm256_set1_ps(2.0f);
+    const __m256 sign = _mm256_set1_ps(-0.0f);
+    __m256 A = _mm256_sub_ps(_mm256_mul_ps(_mm256_mul_ps(two, a), r1), a);
+    __m256 C = _mm256_mul_ps(two, r2);
+    __m256 D = _mm256_andnot_ps(sign, _mm256_sub_ps(_mm256_mul_ps(C, leader), x));
+    return _mm256_sub_ps(leader, _mm256_mul_ps(A, D));
+}
+
+__attribute__((target("avx2")))
+void update_block_avx2(float* position, const FloatLeaderPositions& leaders,
+                       const float* lower, const float* upper,
+                       const BlockRandoms<float>& r, float a, std::size_t count) {
+    const __m256 va = _mm256_set1_ps(a);
+    const __m256 three = _mm256_set1_ps(3.0f);
+
+    std::size_t j = 0;
+    for (; j + 8 <= count; j += 8) {
+        __m256 x = _mm256_loadu_ps(position + j);
+        __m256 X1 = pull_avx2(x, _mm256_loadu_ps(leaders.alpha + j), va,
+                              _mm256_loadu_ps(r.r1_alpha + j), _mm256_loadu_ps(r.r2_alpha + j));
+        __m256 X2 = pull_avx2(x, _mm256_loadu_ps(leaders.beta + j), va,
+                              _mm256_loadu_ps(r.r1_beta + j), _mm256_loadu_ps(r.r2_beta + j));
+        __m256 X3 = pull_avx2(x, _mm256_loadu_ps(leaders.delta + j), va,
+                              _mm256_loadu_ps(r.r1_delta + j), _mm256_loadu_ps(r.r2_delta + j));
+
+        __m256 mean = _mm256_div_ps(_mm256_add_ps(_mm256_add_ps(X1, X2), X3), three);
+        mean = _mm256_max_ps(mean, _mm256_loadu_ps(lower + j));
+        mean = _mm256_min_ps(mean, _mm256_loadu_ps(upper + j));
+        _mm256_storeu_ps(position + j, mean);
+    }
+    for (; j < count; ++j) {
+        update_one(position, leaders, lower, upper, r, a, j);
+    }
+}
+
+__attribute__((target("avx512f")))
+inline __m512 pull_avx512(__m512 x, __m512 leader, __m512 a, __m512 r1, __m512 r2) {
+    const __m512 two = _mm512_set1_ps(2.0f);
+    __m512 A = _mm512_sub_ps(_mm512_mul_ps(_mm512_mul_ps(two, a), r1), a);
+    __m512 C = _mm512_mul_ps(two, r2);
+    __m512 D = _mm512_abs_ps(_mm512_sub_ps(_mm512_mul_ps(C, leader), x));
+    return _mm512_sub_ps(leader, _mm512_mul_ps(A, D));
+}
+
+__attribute__((target("avx512f")))
+void update_block_avx512(float* position, const FloatLeaderPositions& leaders,
+                         const float* lower, const float* upper,
+                         const BlockRandoms<float>& r, float a, std::size_t count) {
+    const __m512 va = _mm512_set1_ps(a);
+    const __m512 three = _mm512_set1_ps(3.0f);
+
+    std::size_t j = 0;
+    for (; j + 16 <= count; j += 16) {
+        __m512 x = _mm512_loadu_ps(position + j);
+        __m512 X1 = pull_avx512(x, _mm512_loadu_ps(leaders.alpha + j), va,
+                                _mm512_loadu_ps(r.r1_alpha + j), _mm512_loadu_ps(r.r2_alpha + j));
+        __m512 X2 = pull_avx512(x, _mm512_loadu_ps(leaders.beta + j), va,
+                                _mm512_loadu_ps(r.r1_beta + j), _mm512_loadu_ps(r.r2_beta + j));
+        __m512 X3 = pull_avx512(x, _mm512_loadu_ps(leaders.delta + j), va,
+                                _mm512_loadu_ps(r.r1_delta + j), _mm512_loadu_ps(r.r2_delta + j));
+
+        __m512 mean = _mm512_div_ps(_mm512_add_ps(_mm512_add_ps(X1, X2), X3), three);
+        mean = _mm512_max_ps(mean, _mm512_loadu_ps(lower + j));
+        mean = _mm512_min_ps(mean, _mm512_loadu_ps(upper + j));
+        _mm512_storeu_ps(position + j, mean);
+    }
+    for (; j < count; ++j) {
+        update_one(position, leaders, lower, upper, r, a, j);
+    }
+}
+
+#endif // GWO_HAVE_X86_SIMD
+
+// Draws the coefficients a block at a time and runs the kernel of `isa` on each block
+template <typename T>
+void update_blocks(T* position, const BasicLeaderPositions<T>& leaders,
+                   const T* lower, const T* upper,
+                   std::size_t dimension, T a, VectorRng& rng, SimdIsa isa) {
+    alignas(64) T random[6 * update_block_size];
+
+    for (std::size_t start = 0; start < dimension; start += update_block_size) {
+        std::size_t count = std::min(update_block_size, dimension - start);
+        rng.fill_uniform(random, 6 * count, isa);
+
+        BlockRandoms<T> r(random, count);
+        BasicLeaderPositions<T> block = { leaders.alpha + start, leaders.beta + start, leaders.delta + start };
+        T* wolf = position + start;
+
+        switch (isa) {
+#ifdef GWO_HAVE_X86_SIMD
+            case SimdIsa::Avx512:
+                update_block_avx512(wolf, block, lower + start, upper + start, r, a, count);
+                break;
+            case SimdIsa::Avx2:
+                update_block_avx2(wolf, block, lower + start, upper + start, r, a, count);
+                break;
+#endif
+            default:
+                update_block_scalar(wolf, block, lower + start, upper + start, r, a, count);
+                break;
+        }
+    }
+}
+
+} // namespace
+
+void update_wolf(double* position, const LeaderPositions& leaders,
+                 const double* lower, const double* upper,
+                 std::size_t dimension, double a, VectorRng& rng) {
+    static const SimdIsa isa = detect_simd_isa();
+    update_blocks(position, leaders, lower, upper, dimension, a, rng, isa);
+}
+
+void update_wolf(double* position, const LeaderPositions& leaders,
+                 const double* lower, const double* upper,
+                 std::size_t dimension, double a, VectorRng& rng, SimdIsa isa) {
+    update_blocks(position, leaders, lower, upper, dimension, a, rng, isa);
+}
+
+void update_wolf(float* position, const FloatLeaderPositions& leaders,
+                 const float* lower, const float* upper,
+                 std::size_t dimension, double a, VectorRng& rng) {
+    static const SimdIsa isa = detect_simd_isa();
+    update_blocks(position, leaders, lower, upper, dimension, static_cast<float>(a), rng, isa);
+}
+
+void update_wolf(float* position, const FloatLeaderPositions& leaders,
+                 const float* lower, const float* upper,
+                 std::size_t dimension, double a, VectorRng& rng, SimdIsa isa) {
+    update_blocks(position, leaders, lower, upper, dimension, static_cast<float>(a), rng, isa);
+}